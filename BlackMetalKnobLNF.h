@@ -1,6 +1,8 @@
 // BlackMetalKnobLNF.h
 #pragma once
 #include <JuceHeader.h>
+#include "LnfImageCache.h"
+#include "ReverbProfiler.h"
 
 // =======================================
 // Black Metal Knob LookAndFeel
@@ -21,24 +23,33 @@ public:
             static_cast<float>(w),
             static_cast<float>(h)).reduced(6.0f);
 
+        DRMK_PROFILE_PAINT();
+
         const float radius = bounds.getWidth() * 0.5f;
         const float angle = rotaryStartAngle
             + sliderPos * (rotaryEndAngle - rotaryStartAngle);
 
-        // Outer ring
-        g.setColour(juce::Colour(15, 15, 15));
-        g.fillEllipse(bounds);
+        // The body doesn't rotate, so it is rendered once per size and blitted
+        images->draw(g, LnfImageCache::knobBody, bounds.getX(), bounds.getY(),
+            static_cast<int>(bounds.getWidth()), static_cast<int>(bounds.getHeight()),
+            [](juce::Graphics& ig, juce::Rectangle<float> body) {
+                const float bodyRadius = body.getWidth() * 0.5f;
+
+                // Outer ring
+                ig.setColour(juce::Colour(15, 15, 15));
+                ig.fillEllipse(body);
 
-        // Inner metal gradient
-        juce::ColourGradient grad(
-            juce::Colour(45, 45, 45),
-            bounds.getCentreX(), bounds.getY(),
-            juce::Colour(10, 10, 10),
-            bounds.getCentreX(), bounds.getBottom(),
-            false);
+                // Inner metal gradient
+                juce::ColourGradient grad(
+                    juce::Colour(45, 45, 45),
+                    body.getCentreX(), body.getY(),
+                    juce::Colour(10, 10, 10),
+                    body.getCentreX(), body.getBottom(),
+                    false);
 
-        g.setGradientFill(grad);
-        g.fillEllipse(bounds.reduced(radius * 0.15f));
+                ig.setGradientFill(grad);
+                ig.fillEllipse(body.reduced(bodyRadius * 0.15f));
+            });
 
         // Indicator
         juce::Path p;
@@ -49,4 +60,7 @@ public:
             juce::AffineTransform::rotation(angle)
             .translated(bounds.getCentre()));
     }
+
+private:
+    juce::SharedResourcePointer<LnfImageCache> images;
 };
\ No newline at end of file
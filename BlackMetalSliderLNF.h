@@ -1,6 +1,8 @@
 // BlackMetalSliderLNF.h
 #pragma once
 #include <JuceHeader.h>
+#include "LnfImageCache.h"
+#include "ReverbProfiler.h"
 
 // =======================================
 // Black Metal Slider LookAndFeel (Horizontal)
@@ -22,14 +24,20 @@ public:
             static_cast<float>(width),
             static_cast<float>(height)).reduced(2.0f);
 
+        DRMK_PROFILE_PAINT();
+
         const float sliderHeight = bounds.getHeight() * 0.6f;
         const float trackHeight = sliderHeight * 0.3f;
         const float centerY = bounds.getCentreY();
 
-        // Draw track background
-        g.setColour(juce::Colour(15, 15, 15));
-        g.fillRoundedRectangle(bounds.getX(), centerY - trackHeight * 0.5f,
-            bounds.getWidth(), trackHeight, trackHeight * 0.5f);
+        // Draw track background (static, cached per size)
+        images->draw(g, LnfImageCache::sliderTrack, bounds.getX(), bounds.getY(),
+            static_cast<int>(bounds.getWidth()), static_cast<int>(bounds.getHeight()),
+            [trackHeight](juce::Graphics& ig, juce::Rectangle<float> track) {
+                ig.setColour(juce::Colour(15, 15, 15));
+                ig.fillRoundedRectangle(track.getX(), track.getCentreY() - trackHeight * 0.5f,
+                    track.getWidth(), trackHeight, trackHeight * 0.5f);
+            });
 
         // Draw track foreground (filled portion)
         const float fillWidth = sliderPos * bounds.getWidth();
@@ -47,29 +55,38 @@ public:
                 fillWidth, trackHeight, trackHeight * 0.5f);
         }
 
-        // Draw slider thumb
-        const float thumbWidth = sliderHeight * 0.8f;
-        const float thumbHeight = sliderHeight * 1.2f;
-        const float thumbX = bounds.getX() + sliderPos * bounds.getWidth() - thumbWidth * 0.5f;
-        const float thumbY = centerY - thumbHeight * 0.5f;
+        // Draw slider thumb, snapped to whole pixels so the cached image blits 1:1.
+        // Its size is rounded up too, so the image matches the size it is cached under.
+        const float thumbWidth = std::ceil(sliderHeight * 0.8f);
+        const float thumbHeight = std::ceil(sliderHeight * 1.2f);
+        const float thumbX = std::round(bounds.getX() + sliderPos * bounds.getWidth() - thumbWidth * 0.5f);
+        const float thumbY = std::round(centerY - thumbHeight * 0.5f);
 
-        juce::ColourGradient thumbGrad(
-            juce::Colour(45, 45, 45),
-            thumbX + thumbWidth * 0.5f, thumbY,
-            juce::Colour(10, 10, 10),
-            thumbX + thumbWidth * 0.5f, thumbY + thumbHeight,
-            false);
+        // One pixel of padding keeps the outline stroke inside the image
+        images->draw(g, LnfImageCache::sliderThumb, thumbX - 1.0f, thumbY - 1.0f,
+            static_cast<int>(thumbWidth) + 2, static_cast<int>(thumbHeight) + 2,
+            [thumbWidth, thumbHeight](juce::Graphics& ig, juce::Rectangle<float>) {
+                juce::ColourGradient thumbGrad(
+                    juce::Colour(45, 45, 45),
+                    1.0f + thumbWidth * 0.5f, 1.0f,
+                    juce::Colour(10, 10, 10),
+                    1.0f + thumbWidth * 0.5f, 1.0f + thumbHeight,
+                    false);
 
-        g.setGradientFill(thumbGrad);
-        g.fillRoundedRectangle(thumbX, thumbY, thumbWidth, thumbHeight, 2.0f);
+                ig.setGradientFill(thumbGrad);
+                ig.fillRoundedRectangle(1.0f, 1.0f, thumbWidth, thumbHeight, 2.0f);
 
-        // Draw thumb outline
-        g.setColour(juce::Colour(80, 80, 80));
-        g.drawRoundedRectangle(thumbX, thumbY, thumbWidth, thumbHeight, 2.0f, 1.0f);
+                // Draw thumb outline
+                ig.setColour(juce::Colour(80, 80, 80));
+                ig.drawRoundedRectangle(1.0f, 1.0f, thumbWidth, thumbHeight, 2.0f, 1.0f);
+            });
 
         // Draw center indicator line
         g.setColour(juce::Colour(100, 100, 100));
         g.drawLine(bounds.getCentreX(), thumbY,
             bounds.getCentreX(), thumbY + thumbHeight, 0.5f);
     }
+
+private:
+    juce::SharedResourcePointer<LnfImageCache> images;
 };
\ No newline at end of file
@@ -0,0 +1,350 @@
+// GoldenOutput.h
+#pragma once
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+//==============================================================================
+// Golden-output regression renders
+// Renders fixed input signals through each DSP primitive and the full
+// ReverbProcessor (several sample rates and parameter sets, then every network
+// size, mode, freeze and ducking at one rate), stores the scalar output as a
+// reference, and compares later renders against it with a ULP or dB
+// tolerance. Used to validate block/SIMD rewrites of the DSP.
+// References are only bit-exact for the platform and compiler that wrote them.
+//==============================================================================
+class GoldenOutput
+{
+public:
+    struct Case
+    {
+        juce::String name;
+        std::vector<float> output;  // interleaved for stereo cases
+    };
+
+    // Either limit may be used: a case passes if it is within maxUlps of the
+    // reference at every sample, or its error is at most maxErrorDb below the
+    // reference RMS. The defaults demand bit-exact output.
+    struct Tolerance
+    {
+        uint32_t maxUlps = 0;
+        float maxErrorDb = -std::numeric_limits<float>::infinity();
+    };
+
+    struct Comparison
+    {
+        juce::String name;
+        uint32_t worstUlps = 0;
+        float errorDb = -std::numeric_limits<float>::infinity();  // error RMS relative to reference RMS
+        bool passed = false;
+    };
+
+    static constexpr int primitiveLength = 4096;
+    static constexpr double reverbSeconds = 0.25;
+    static constexpr double variantSampleRate = 48000.0;
+    static constexpr int fileMagic = 0x444c4f47;  // "GOLD"
+
+    //==============================================================================
+    // Deterministic inputs, independent of the JUCE version and libm
+    static std::vector<float> makeImpulse(int length)
+    {
+        std::vector<float> x(static_cast<size_t>(length), 0.0f);
+        if (length > 0) x[0] = 1.0f;
+        return x;
+    }
+
+    static std::vector<float> makeNoise(int length, uint32_t seed = 0x1234567u)
+    {
+        std::vector<float> x(static_cast<size_t>(length));
+        for (auto& v : x) {
+            seed = seed * 1664525u + 1013904223u;
+            v = static_cast<float>(static_cast<int32_t>(seed >> 8) - (1 << 23)) / static_cast<float>(1 << 24);
+        }
+        return x;
+    }
+
+    //==============================================================================
+    static std::vector<Case> renderAll()
+    {
+        std::vector<Case> cases;
+        const auto impulse = makeImpulse(primitiveLength);
+        const auto noise = makeNoise(primitiveLength);
+
+        for (const auto* input : { &impulse, &noise }) {
+            const juce::String suffix = input == &impulse ? " impulse" : " noise";
+
+            {
+                OnePole<float> lowpass;
+                cases.push_back({ "onepole" + suffix, render(*input, [&](float x) { return lowpass.process(x, 0.7f); }) });
+            }
+            {
+                CombFilter<float> comb;
+                comb.setSize(1117);
+                comb.setFeedback(0.84f);
+                comb.setDamp(0.2f);
+                cases.push_back({ "comb" + suffix, render(*input, [&](float x) { return comb.process(x); }) });
+            }
+            {
+                CombFilter<float> comb;
+                comb.setSize(1277);
+                comb.setFeedback(0.8f);
+                comb.setDamp(0.3f);
+                comb.setShelves(0.965f, 0.56f, 1.02f, 0.9f);
+                cases.push_back({ "comb shelved" + suffix, render(*input, [&](float x) { return comb.process(x); }) });
+            }
+            {
+                AllpassFilter<float> allpass;
+                allpass.setSize(556);
+                allpass.setCoeff(0.5f);
+                cases.push_back({ "allpass" + suffix, render(*input, [&](float x) { return allpass.process(x); }) });
+            }
+            for (bool nested : { false, true }) {
+                AllpassCascade<float> cascade;
+                cascade.setNumStages(4);
+                const int sizes[] = { 221, 75, 560, 410 };
+                for (int stage = 0; stage < 4; ++stage) {
+                    cascade.setSize(stage, sizes[stage]);
+                    cascade.setCoeff(stage, stage < 2 ? 0.42f : 0.5f);
+                    cascade.setNestedSize(stage, nested ? sizes[stage] / 3 : 0);
+                }
+                auto output = *input;
+                cascade.process(output.data(), static_cast<int>(output.size()));
+                cases.push_back({ (nested ? "allpass lattice" : "allpass cascade") + suffix, output });
+            }
+            {
+                DelayLine<float> delay;
+                delay.setSize(2000);
+                delay.setDelay(441);
+                cases.push_back({ "delay" + suffix, render(*input, [&](float x) { return delay.process(x); }) });
+            }
+        }
+
+        for (double sampleRate : { 44100.0, 48000.0, 96000.0 })
+            for (const auto& set : getParameterSets())
+                cases.push_back({ "reverb " + set.name + " " + juce::String(static_cast<int>(sampleRate)),
+                    renderReverb(set, sampleRate) });
+
+        for (const auto& set : getVariantSets())
+            cases.push_back({ "reverb " + set.name + " " + juce::String(static_cast<int>(variantSampleRate)),
+                renderReverb(set, variantSampleRate) });
+
+        return cases;
+    }
+
+    //==============================================================================
+    // Binary reference file: magic, case count, then name, length and samples per case
+    static void write(const std::vector<Case>& cases, juce::OutputStream& out)
+    {
+        out.writeInt(fileMagic);
+        out.writeInt(static_cast<int>(cases.size()));
+        for (const auto& c : cases) {
+            out.writeString(c.name);
+            out.writeInt(static_cast<int>(c.output.size()));
+            for (float v : c.output)
+                out.writeFloat(v);
+        }
+    }
+
+    // Empty if the stream is not a reference file
+    static std::vector<Case> read(juce::InputStream& in)
+    {
+        std::vector<Case> cases;
+        if (in.readInt() != fileMagic)
+            return cases;
+
+        const int numCases = in.readInt();
+        for (int i = 0; i < numCases && !in.isExhausted(); ++i) {
+            Case c;
+            c.name = in.readString();
+            const int length = in.readInt();
+            if (length < 0 || in.getNumBytesRemaining() < static_cast<long long>(length) * static_cast<long long>(sizeof(float)))
+                break;
+
+            c.output.resize(static_cast<size_t>(length));
+            for (auto& v : c.output)
+                v = in.readFloat();
+            cases.push_back(std::move(c));
+        }
+        return cases;
+    }
+
+    //==============================================================================
+    static std::vector<Comparison> compare(const std::vector<Case>& reference, const std::vector<Case>& rendered,
+        const Tolerance& tolerance)
+    {
+        std::vector<Comparison> results;
+
+        for (const auto& ref : reference) {
+            Comparison result;
+            result.name = ref.name;
+
+            auto match = std::find_if(rendered.begin(), rendered.end(), [&](const Case& c) { return c.name == ref.name; });
+            if (match == rendered.end() || match->output.size() != ref.output.size()) {
+                result.worstUlps = std::numeric_limits<uint32_t>::max();
+                result.errorDb = std::numeric_limits<float>::infinity();
+                results.push_back(result);
+                continue;
+            }
+
+            double errorPower = 0.0, referencePower = 0.0;
+            for (size_t i = 0; i < ref.output.size(); ++i) {
+                const float a = ref.output[i], b = match->output[i];
+                result.worstUlps = juce::jmax(result.worstUlps, ulpDistance(a, b));
+                errorPower += static_cast<double>(a - b) * (a - b);
+                referencePower += static_cast<double>(a) * a;
+            }
+
+            if (errorPower > 0.0)
+                result.errorDb = referencePower > 0.0
+                    ? static_cast<float>(10.0 * std::log10(errorPower / referencePower))
+                    : std::numeric_limits<float>::infinity();
+
+            result.passed = result.worstUlps <= tolerance.maxUlps || result.errorDb <= tolerance.maxErrorDb;
+            results.push_back(result);
+        }
+        return results;
+    }
+
+    // Units in the last place between two floats; NaNs are infinitely far apart
+    static uint32_t ulpDistance(float a, float b)
+    {
+        if (std::isnan(a) || std::isnan(b))
+            return std::numeric_limits<uint32_t>::max();
+
+        auto ordered = [](float f) {
+            int32_t i;
+            std::memcpy(&i, &f, sizeof(i));
+            return i < 0 ? static_cast<int64_t>(std::numeric_limits<int32_t>::min()) - i : static_cast<int64_t>(i);
+        };
+
+        const int64_t d = ordered(a) - ordered(b);
+        return static_cast<uint32_t>(juce::jmin<int64_t>(d < 0 ? -d : d, std::numeric_limits<uint32_t>::max()));
+    }
+
+private:
+    struct ParameterSet
+    {
+        juce::String name;
+        ReverbParameters params;
+        ReverbNetworkSize size = ReverbNetworkSize::standard;
+        bool freezeAfterBurst = false;  // hold the tail once the input burst has ended
+        bool keyed = false;             // duck under a separate sidechain signal
+    };
+
+    static std::vector<ParameterSet> getParameterSets()
+    {
+        std::vector<ParameterSet> sets(3);
+        sets[0].name = "default";
+
+        sets[1].name = "small dark";
+        sets[1].params[ReverbParameters::decay] = 0.6f;
+        sets[1].params[ReverbParameters::size] = 0.4f;
+        sets[1].params[ReverbParameters::damping] = 0.8f;
+        sets[1].params[ReverbParameters::mix] = 1.0f;
+
+        sets[2].name = "large banded";
+        sets[2].params[ReverbParameters::decay] = 6.0f;
+        sets[2].params[ReverbParameters::size] = 1.6f;
+        sets[2].params[ReverbParameters::damping] = 0.2f;
+        sets[2].params[ReverbParameters::lowDecay] = 1.5f;
+        sets[2].params[ReverbParameters::highDecay] = 0.5f;
+        return sets;
+    }
+
+    // The other network sizes, the late-output modes, freeze and ducking
+    static std::vector<ParameterSet> getVariantSets()
+    {
+        std::vector<ParameterSet> sets(8);
+        sets[0].name = "lite";
+        sets[0].size = ReverbNetworkSize::lite;
+
+        sets[1].name = "dense";
+        sets[1].size = ReverbNetworkSize::dense;
+
+        sets[2].name = "lite small dark";
+        sets[2].size = ReverbNetworkSize::lite;
+        sets[2].params = getParameterSets()[1].params;
+
+        sets[3].name = "gated";
+        sets[3].params[ReverbParameters::mode] = static_cast<float>(ReverbMode::gated);
+        sets[3].params[ReverbParameters::gateLength] = 100.0f;
+
+        sets[4].name = "reverse";
+        sets[4].params[ReverbParameters::mode] = static_cast<float>(ReverbMode::reverse);
+        sets[4].params[ReverbParameters::gateLength] = 80.0f;
+
+        sets[5].name = "freeze";
+        sets[5].freezeAfterBurst = true;
+
+        sets[6].name = "ducked";
+        sets[6].params[ReverbParameters::duck] = 0.8f;
+
+        sets[7].name = "ducked keyed";
+        sets[7].params[ReverbParameters::duck] = 0.8f;
+        sets[7].params[ReverbParameters::duckRelease] = 50.0f;
+        sets[7].keyed = true;
+        return sets;
+    }
+
+    template <typename Process>
+    static std::vector<float> render(const std::vector<float>& input, Process&& process)
+    {
+        std::vector<float> output(input.size());
+        for (size_t i = 0; i < input.size(); ++i)
+            output[i] = process(input[i]);
+        return output;
+    }
+
+    // Stereo noise burst followed by the tail, rendered in uneven block sizes
+    // so sub-block boundaries are exercised as well. Keyed sets duck under a
+    // quieter noise that runs the whole length, starting after the burst.
+    static std::vector<float> renderReverb(const ParameterSet& set, double sampleRate)
+    {
+        auto voice = createReverbVoice<float>(set.size);
+        auto& reverb = *voice;
+        reverb.setParameters(set.params);
+        reverb.prepare(sampleRate);
+
+        const int length = static_cast<int>(sampleRate * reverbSeconds);
+        auto left = makeNoise(length, 0x2468aceu);
+        auto right = makeNoise(length, 0x13579bdu);
+        const int burst = juce::jmin(length, 2048);
+        std::fill(left.begin() + burst, left.end(), 0.0f);
+        std::fill(right.begin() + burst, right.end(), 0.0f);
+
+        auto key = makeNoise(length, 0x7531bdfu);
+        std::fill(key.begin(), key.begin() + burst, 0.0f);
+        for (auto& v : key) v *= 0.25f;
+
+        static constexpr int blockSizes[] = { 64, 257, 512, 1000, 31 };
+        int offset = 0;
+        bool frozen = false;
+        for (int block = 0; offset < length; ++block) {
+            const int n = juce::jmin(blockSizes[block % static_cast<int>(std::size(blockSizes))], length - offset);
+
+            if (set.freezeAfterBurst && !frozen && offset >= burst) {
+                auto params = set.params;
+                params[ReverbParameters::freeze] = 1.0f;
+                reverb.setParameters(params);
+                frozen = true;
+            }
+            if (set.keyed)
+                reverb.setSidechain(key.data() + offset, key.data() + offset);
+
+            reverb.processStereo(left.data() + offset, right.data() + offset, n);
+            offset += n;
+        }
+
+        std::vector<float> interleaved(static_cast<size_t>(length) * 2);
+        for (int i = 0; i < length; ++i) {
+            interleaved[static_cast<size_t>(i) * 2] = left[static_cast<size_t>(i)];
+            interleaved[static_cast<size_t>(i) * 2 + 1] = right[static_cast<size_t>(i)];
+        }
+        return interleaved;
+    }
+};
@@ -0,0 +1,324 @@
+// ReverbHarness.cpp
+// Command-line runner for the offline regression checks in GoldenOutput.h and
+// ReverbMeasurement.h. Each check compares against a reference committed next
+// to this file and exits non-zero on a mismatch; --write regenerates the
+// reference instead.
+//
+//   ReverbHarness golden [--write]    renders against golden.bin
+//   ReverbHarness measure [--write]   IR metrics over the default grid against baseline.xml
+//   ReverbHarness t60                 measured decay of every network size against the decay parameter
+//   ReverbHarness freeze              output energy never grows while freezing or unfreezing
+//   ReverbHarness tiers               cost and IR metrics of each quality tier (report only)
+//   ReverbHarness state               save/load time over 1,000 instances, binary vs. XML (report only)
+//
+// References are looked up in DRMK_HARNESS_DIR (set by the CMake target), or
+// in the directory given with --dir.
+
+#include <JuceHeader.h>
+#include "GoldenOutput.h"
+#include "ReverbMeasurement.h"
+#include <iostream>
+
+#ifndef DRMK_HARNESS_DIR
+ #define DRMK_HARNESS_DIR "."
+#endif
+
+namespace
+{
+    constexpr double measureSampleRate = 48000.0;
+    constexpr double measureSeconds = 8.0;
+
+    struct Options
+    {
+        juce::String command;
+        juce::File directory{ juce::String(DRMK_HARNESS_DIR) };
+        bool write = false;
+    };
+
+    int fail(const juce::String& message)
+    {
+        std::cerr << message << std::endl;
+        return 1;
+    }
+
+    //==============================================================================
+    int runGolden(const Options& options)
+    {
+        const auto file = options.directory.getChildFile("golden.bin");
+        const auto rendered = GoldenOutput::renderAll();
+
+        if (options.write) {
+            juce::FileOutputStream out(file);
+            if (!out.openedOk())
+                return fail("Can't write " + file.getFullPathName());
+
+            out.setPosition(0);
+            out.truncate();
+            GoldenOutput::write(rendered, out);
+            std::cout << "Wrote " << static_cast<int>(rendered.size()) << " cases to " << file.getFullPathName() << std::endl;
+            return 0;
+        }
+
+        juce::FileInputStream in(file);
+        if (!in.openedOk())
+            return fail("Can't read " + file.getFullPathName());
+
+        const auto reference = GoldenOutput::read(in);
+        if (reference.size() != rendered.size())
+            return fail("Reference has " + juce::String(static_cast<int>(reference.size())) + " cases, rendered "
+                + juce::String(static_cast<int>(rendered.size())));
+
+        // Bit-exact only with the compiler that wrote the references; elsewhere
+        // libm and floating-point contraction differences pass down at -100dB
+        GoldenOutput::Tolerance tolerance;
+        tolerance.maxErrorDb = -100.0f;
+
+        int failures = 0;
+        for (const auto& result : GoldenOutput::compare(reference, rendered, tolerance)) {
+            std::cout << (result.passed ? "pass " : "FAIL ") << result.name << ": "
+                << static_cast<juce::int64>(result.worstUlps) << " ulps, error " << juce::String(result.errorDb, 1) << " dB" << std::endl;
+            if (!result.passed)
+                ++failures;
+        }
+        return failures == 0 ? 0 : fail(juce::String(failures) + " golden cases failed");
+    }
+
+    //==============================================================================
+    int runMeasure(const Options& options)
+    {
+        const auto file = options.directory.getChildFile("baseline.xml");
+
+        juce::ThreadPool pool;
+        const auto results = ReverbMeasurement::measureGrid(ReverbMeasurement::makeDefaultGrid(),
+            measureSampleRate, measureSeconds, pool);
+
+        for (const auto& r : results)
+            std::cout << r.point.name << ": T60 " << juce::String(r.metrics.t60, 3) << "s, EDT " << juce::String(r.metrics.edt, 3)
+                << "s, mixing " << juce::String(r.metrics.mixingTimeMs, 1) << "ms, centroid "
+                << juce::roundToInt(r.metrics.centroidEarlyHz) << "/" << juce::roundToInt(r.metrics.centroidLateHz) << "Hz" << std::endl;
+
+        if (options.write) {
+            if (!ReverbMeasurement::createBaseline(results)->writeTo(file))
+                return fail("Can't write " + file.getFullPathName());
+
+            std::cout << "Wrote " << file.getFullPathName() << std::endl;
+            return 0;
+        }
+
+        const auto baseline = juce::parseXML(file);
+        if (baseline == nullptr)
+            return fail("Can't read " + file.getFullPathName());
+
+        const auto deviations = ReverbMeasurement::compareWithBaseline(results, *baseline);
+        for (const auto& deviation : deviations)
+            std::cout << "FAIL " << deviation << std::endl;
+
+        return deviations.isEmpty() ? 0 : fail(juce::String(deviations.size()) + " metrics moved outside tolerance");
+    }
+
+
+    //==============================================================================
+    // Undamped, so the whole band decays at the rate the comb gains are set
+    // for; the measured T60 has to land within the baseline's T60 tolerance
+    int runT60(const Options&)
+    {
+        const float tolerance = ReverbMeasurement::Tolerance().t60;
+        const char* names[] = { "lite", "standard", "dense" };
+        int failures = 0;
+
+        for (auto size : { ReverbNetworkSize::lite, ReverbNetworkSize::standard, ReverbNetworkSize::dense })
+            for (float roomSize : { 0.3f, 0.75f, 1.5f })
+                for (float decay : { 0.5f, 1.0f, 2.0f, 4.0f }) {
+                    ReverbParameters params;
+                    params[ReverbParameters::decay] = decay;
+                    params[ReverbParameters::damping] = 0.0f;
+                    params[ReverbParameters::size] = roomSize;
+
+                    const auto ir = ReverbMeasurement::renderImpulseResponse(params, measureSampleRate, decay * 1.5 + 0.5, size);
+                    const float t60 = ReverbMeasurement::analyse(ir, measureSampleRate).t60;
+                    const float deviation = std::abs(t60 - decay) / decay;
+                    const bool passed = deviation <= tolerance;
+
+                    std::cout << (passed ? "pass " : "FAIL ") << names[static_cast<int>(size)] << " size " << juce::String(roomSize, 2)
+                        << " decay " << juce::String(decay, 1) << "s: T60 " << juce::String(t60, 3) << "s ("
+                        << juce::String(deviation * 100.0f, 1) << "%)" << std::endl;
+                    if (!passed)
+                        ++failures;
+                }
+
+        return failures == 0 ? 0 : fail(juce::String(failures) + " decays missed the requested T60");
+    }
+
+    //==============================================================================
+    // A short decay with a long low band, where a shelf gain well above 1
+    // meets a feedback well below it: freeze after a noise burst, hold, then
+    // release. Once the input stops, no 100ms window may carry more than 3dB
+    // more energy than the loudest of the three before it; the held modes
+    // beat by up to about 2dB, a loop gain past unity adds 10dB or more.
+    int runFreeze(const Options&)
+    {
+        constexpr double burstSeconds = 0.3, holdSeconds = 1.0, totalSeconds = 2.5;
+        constexpr int blockSize = 512;
+        constexpr int windowSize = static_cast<int>(measureSampleRate / 10.0);
+        constexpr int lookBack = 3;
+        const double maxGrowth = std::pow(10.0, 3.0 / 10.0);
+        const char* names[] = { "lite", "standard", "dense" };
+        int failures = 0;
+
+        for (auto size : { ReverbNetworkSize::lite, ReverbNetworkSize::standard, ReverbNetworkSize::dense }) {
+            ReverbParameters params;
+            params[ReverbParameters::decay] = 0.1f;
+            params[ReverbParameters::lowDecay] = 4.0f;
+            params[ReverbParameters::mix] = 1.0f;
+
+            auto voice = createReverbVoice<float>(size);
+            voice->setParameters(params);
+            voice->prepare(measureSampleRate);
+
+            const int length = static_cast<int>(measureSampleRate * totalSeconds);
+            const int burst = static_cast<int>(measureSampleRate * burstSeconds);
+            const int release = static_cast<int>(measureSampleRate * (burstSeconds + holdSeconds));
+
+            juce::AudioBuffer<float> buffer(2, length);
+            buffer.clear();
+            juce::Random random(0x5eed);
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < burst; ++i)
+                    buffer.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * 0.05f);
+
+            for (int offset = 0; offset < length; offset += blockSize) {
+                params[ReverbParameters::freeze] = offset >= burst && offset < release ? 1.0f : 0.0f;
+                voice->setParameters(params);
+                voice->processStereo(buffer.getWritePointer(0) + offset, buffer.getWritePointer(1) + offset,
+                    juce::jmin(blockSize, length - offset));
+            }
+
+            std::vector<double> energy;
+            for (int offset = 0; offset + windowSize <= length; offset += windowSize) {
+                double sum = 0.0;
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < windowSize; ++i)
+                        sum += juce::square(static_cast<double>(buffer.getSample(ch, offset + i)));
+                energy.push_back(sum);
+            }
+
+            double worstGrowth = 0.0;
+            for (size_t w = static_cast<size_t>(burst / windowSize) + lookBack; w < energy.size(); ++w) {
+                const double recent = *std::max_element(energy.begin() + static_cast<std::ptrdiff_t>(w - lookBack),
+                    energy.begin() + static_cast<std::ptrdiff_t>(w));
+                if (recent > 0.0)
+                    worstGrowth = juce::jmax(worstGrowth, energy[w] / recent);
+            }
+
+            const bool passed = worstGrowth <= maxGrowth;
+            std::cout << (passed ? "pass " : "FAIL ") << names[static_cast<int>(size)] << ": worst growth "
+                << juce::String(10.0 * std::log10(worstGrowth), 2) << " dB" << std::endl;
+            if (!passed)
+                ++failures;
+        }
+
+        return failures == 0 ? 0 : fail(juce::String(failures) + " network sizes grew while freezing or unfreezing");
+    }
+
+    //==============================================================================
+    int runTiers(const Options&)
+    {
+        for (const auto& tier : ReverbMeasurement::measureQualityTiers(ReverbParameters(), measureSampleRate, measureSeconds))
+            std::cout << tier.name << ": " << juce::String(tier.nanosPerSample, 1) << " ns/sample, T60 "
+                << juce::String(tier.metrics.t60, 3) << "s, EDT " << juce::String(tier.metrics.edt, 3) << "s, mixing "
+                << juce::String(tier.metrics.mixingTimeMs, 1) << "ms, centroid " << juce::roundToInt(tier.metrics.centroidEarlyHz)
+                << "/" << juce::roundToInt(tier.metrics.centroidLateHz) << "Hz" << std::endl;
+        return 0;
+    }
+
+    //==============================================================================
+    // Session load and autosave: every instance saves and restores its state,
+    // once as the binary blob and once as the XML state that sessions saved
+    // before it hold. Each instance runs a different factory program. Times
+    // are the best of several passes; a state that doesn't survive the round
+    // trip fails.
+    int runState(const Options&)
+    {
+        constexpr int numInstances = 1000;
+        constexpr int numRuns = 5;
+
+        std::vector<std::unique_ptr<DSP256XLReverbProcessor>> processors;
+        for (int i = 0; i < numInstances; ++i) {
+            processors.push_back(std::make_unique<DSP256XLReverbProcessor>());
+            processors.back()->setCurrentProgram(i % DSP256XLReverbProcessor::getNumFactoryPrograms());
+        }
+
+        std::vector<juce::MemoryBlock> binary(numInstances), xml(numInstances), restored(numInstances);
+
+        auto saveBinary = [&](size_t i) { processors[i]->getStateInformation(binary[i]); };
+        auto loadBinary = [&](size_t i) { processors[i]->setStateInformation(binary[i].getData(), static_cast<int>(binary[i].getSize())); };
+        auto saveXml = [&](size_t i) {
+            juce::AudioProcessor::copyXmlToBinary(*processors[i]->getAPVTS().copyState().createXml(), xml[i]);
+        };
+        auto loadXml = [&](size_t i) { processors[i]->setStateInformation(xml[i].getData(), static_cast<int>(xml[i].getSize())); };
+
+        auto bestMillis = [&](auto&& action) {
+            double best = std::numeric_limits<double>::max();
+            for (int run = 0; run < numRuns; ++run) {
+                const double start = juce::Time::getMillisecondCounterHiRes();
+                for (size_t i = 0; i < processors.size(); ++i)
+                    action(i);
+                best = juce::jmin(best, juce::Time::getMillisecondCounterHiRes() - start);
+            }
+            return best;
+        };
+
+        auto roundTrips = [&]() {
+            for (size_t i = 0; i < processors.size(); ++i) {
+                processors[i]->getStateInformation(restored[i]);
+                if (restored[i] != binary[i])
+                    return false;
+            }
+            return true;
+        };
+
+        const double binarySave = bestMillis(saveBinary);
+        const double binaryLoad = bestMillis(loadBinary);
+        if (!roundTrips())
+            return fail("Binary state changed on the round trip");
+
+        const double xmlSave = bestMillis(saveXml);
+        const double xmlLoad = bestMillis(loadXml);
+        if (!roundTrips())
+            return fail("XML state changed on the round trip");
+
+        auto report = [](const char* name, double save, double load, size_t bytes) {
+            std::cout << name << ": save " << juce::String(save, 2) << " ms, load " << juce::String(load, 2) << " ms, "
+                << static_cast<int>(bytes) << " bytes per instance" << std::endl;
+        };
+        std::cout << numInstances << " instances, best of " << numRuns << " passes" << std::endl;
+        report("binary", binarySave, binaryLoad, binary.front().getSize());
+        report("xml", xmlSave, xmlLoad, xml.front().getSize());
+        return 0;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const juce::String arg(argv[i]);
+        if (arg == "--write")
+            options.write = true;
+        else if (arg == "--dir" && i + 1 < argc)
+            options.directory = juce::File(juce::String(argv[++i]));
+        else
+            options.command = arg;
+    }
+
+    if (options.command == "golden") return runGolden(options);
+    if (options.command == "measure") return runMeasure(options);
+    if (options.command == "t60") return runT60(options);
+    if (options.command == "freeze") return runFreeze(options);
+    if (options.command == "tiers") return runTiers(options);
+    if (options.command == "state") return runState(options);
+
+    std::cerr << "Usage: ReverbHarness <golden|measure|t60|freeze|tiers|state> [--write] [--dir <reference directory>]" << std::endl;
+    return 2;
+}
@@ -0,0 +1,201 @@
+// LateNetworkHelper.h
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+//==============================================================================
+// Second core for one plugin instance in real time
+// The audio thread dispatches one task per block (the right channel's late
+// network) and runs its own half; join() is a lock-free barrier. If the helper
+// has not claimed the task by then, the audio thread runs it itself, so a late
+// or descheduled helper never makes the audio thread wait for a wake-up.
+// The helper only runs while dual-core mode is on and never blocks on an
+// event: when idle it spins, then yields, then polls with short sleeps. So
+// dispatch() is a plain atomic store and the audio thread never takes a lock.
+//==============================================================================
+class LateNetworkHelper : private juce::Thread
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Task = void (*)(void* context, int numSamples);
+
+    struct Stats
+    {
+        uint64_t handoffs = 0;        // tasks run by the helper
+        uint64_t stolen = 0;          // tasks taken back by the audio thread
+        float wakeMicros = 0.0f;      // smoothed dispatch -> helper start
+        float worstWakeMicros = 0.0f;
+        float waitMicros = 0.0f;      // smoothed time the audio thread spent at the barrier
+        float worstWaitMicros = 0.0f;
+    };
+
+    // After this long without a task the helper stops spinning and yields
+    static constexpr int idleSpinMicros = 2000;
+    // After this long it polls with short sleeps instead (transport stopped)
+    static constexpr int idleYieldMicros = 50000;
+    static constexpr int idlePollMillis = 1;
+
+    LateNetworkHelper() : juce::Thread("DRMKII late network helper") {}
+    ~LateNetworkHelper() override { stop(); }
+
+    // Message thread
+    void start()
+    {
+        if (isThreadRunning()) return;
+
+        resetStats();
+
+        // Keep the helper on one core so its caches stay warm between blocks.
+        // The mask is applied when the thread starts, and each instance takes
+        // the next core (leaving core 0 to the host) so helpers don't pile up.
+        const int numCpus = juce::SystemStats::getNumCpus();
+        if (numCpus > 2 && numCpus <= 32) {
+            static std::atomic<unsigned int> nextCore{ 0 };
+            const auto core = 1u + nextCore.fetch_add(1, std::memory_order_relaxed) % static_cast<unsigned int>(numCpus - 1);
+            setAffinityMask(1u << core);
+        }
+
+        startRealtimeThread(juce::Thread::RealtimeOptions().withPriority(9));
+    }
+
+    void stop()
+    {
+        signalThreadShouldExit();
+        stopThread(1000);
+    }
+
+    bool isRunning() const { return isThreadRunning(); }
+
+    // Audio thread: hand a task to the helper; must be followed by join()
+    void dispatch(Task task, void* context, int numSamples) noexcept
+    {
+        pendingTask = task;
+        pendingContext = context;
+        pendingSamples = numSamples;
+        dispatchTime = Clock::now();
+        state.store(pending, std::memory_order_release);
+    }
+
+    // Audio thread: returns once the dispatched task has run
+    void join() noexcept
+    {
+        int expected = pending;
+        if (state.compare_exchange_strong(expected, claimed, std::memory_order_acq_rel)) {
+            pendingTask(pendingContext, pendingSamples);
+            stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+        else {
+            const auto waitStart = Clock::now();
+            while (state.load(std::memory_order_acquire) != done)
+                spinPause();
+            record(waitMicros, worstWaitMicros, Clock::now() - waitStart);
+        }
+
+        state.store(idle, std::memory_order_relaxed);
+    }
+
+    Stats getStats() const
+    {
+        Stats s;
+        s.handoffs = handoffs.load(std::memory_order_relaxed);
+        s.stolen = stolen.load(std::memory_order_relaxed);
+        s.wakeMicros = wakeMicros.load(std::memory_order_relaxed);
+        s.worstWakeMicros = worstWakeMicros.load(std::memory_order_relaxed);
+        s.waitMicros = waitMicros.load(std::memory_order_relaxed);
+        s.worstWaitMicros = worstWaitMicros.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    juce::String getSummary() const
+    {
+        const auto s = getStats();
+        return "2CPU WK " + juce::String(s.wakeMicros, 0) + "/" + juce::String(s.worstWakeMicros, 0)
+            + "us WT " + juce::String(s.waitMicros, 0) + "/" + juce::String(s.worstWaitMicros, 0)
+            + "us " + juce::String(static_cast<juce::int64>(s.stolen)) + " ST";
+    }
+
+private:
+    enum State { idle = 0, pending, claimed, done };
+
+    void run() override
+    {
+        auto lastTask = Clock::now();
+
+        while (!threadShouldExit()) {
+            int expected = pending;
+            if (state.compare_exchange_strong(expected, claimed, std::memory_order_acq_rel)) {
+                record(wakeMicros, worstWakeMicros, Clock::now() - dispatchTime);
+
+                pendingTask(pendingContext, pendingSamples);
+                handoffs.fetch_add(1, std::memory_order_relaxed);
+                state.store(done, std::memory_order_release);
+                lastTask = Clock::now();
+                continue;
+            }
+
+            const auto idleFor = Clock::now() - lastTask;
+            if (idleFor < std::chrono::microseconds(idleSpinMicros))
+                spinPause();
+            else if (idleFor < std::chrono::microseconds(idleYieldMicros))
+                std::this_thread::yield();
+            else
+                // Idle between transport runs. Nothing wakes the helper, so a
+                // dispatch may wait up to this long; join() takes the task back
+                // if it hasn't been claimed by then.
+                juce::Thread::sleep(idlePollMillis);
+        }
+    }
+
+    // Eases off the core (and its hyperthread sibling) while spinning
+    static void spinPause() noexcept
+    {
+#if JUCE_INTEL
+        _mm_pause();
+#elif JUCE_ARM && (JUCE_CLANG || JUCE_GCC)
+        __asm__ __volatile__("yield");
+#elif JUCE_ARM && JUCE_MSVC
+        __yield();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    static void record(std::atomic<float>& smoothed, std::atomic<float>& worst, Clock::duration elapsed) noexcept
+    {
+        const auto micros = static_cast<float>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() * 0.001);
+
+        smoothed.store(smoothed.load(std::memory_order_relaxed) * 0.99f + micros * 0.01f, std::memory_order_relaxed);
+        if (micros > worst.load(std::memory_order_relaxed))
+            worst.store(micros, std::memory_order_relaxed);
+    }
+
+    void resetStats()
+    {
+        handoffs.store(0);
+        stolen.store(0);
+        wakeMicros.store(0.0f);
+        worstWakeMicros.store(0.0f);
+        waitMicros.store(0.0f);
+        worstWaitMicros.store(0.0f);
+    }
+
+    // Written by dispatch() before state is published
+    Task pendingTask = nullptr;
+    void* pendingContext = nullptr;
+    int pendingSamples = 0;
+    Clock::time_point dispatchTime;
+
+    std::atomic<int> state{ idle };
+
+    std::atomic<uint64_t> handoffs{ 0 }, stolen{ 0 };
+    std::atomic<float> wakeMicros{ 0.0f }, worstWakeMicros{ 0.0f };
+    std::atomic<float> waitMicros{ 0.0f }, worstWaitMicros{ 0.0f };
+
+    JUCE_DECLARE_NON_COPYABLE(LateNetworkHelper)
+};
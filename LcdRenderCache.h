@@ -0,0 +1,50 @@
+// LcdRenderCache.h
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// Vintage green LCD palette shared by every display
+//==============================================================================
+namespace LcdColours {
+    inline const juce::Colour backlight{ 120, 140, 100 };
+    inline const juce::Colour border{ 60, 70, 50 };
+    inline const juce::Colour ink{ 20, 25, 15 };
+}
+
+//==============================================================================
+// Cached image of an LCD's static layer (backlight and border)
+// Re-rendered only when the component size or the display scale changes.
+//==============================================================================
+class LcdBackgroundCache
+{
+public:
+    template <typename RenderFunction>
+    void draw(juce::Graphics& g, int width, int height, RenderFunction&& render)
+    {
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+        if (image.isNull() || width != cachedWidth || height != cachedHeight || scale != cachedScale) {
+            cachedWidth = width;
+            cachedHeight = height;
+            cachedScale = scale;
+
+            // Render at physical resolution so the cache stays sharp on HiDPI screens
+            image = juce::Image(juce::Image::RGB,
+                juce::jmax(1, juce::roundToInt(width * scale)),
+                juce::jmax(1, juce::roundToInt(height * scale)), false);
+
+            juce::Graphics ig(image);
+            ig.addTransform(juce::AffineTransform::scale(scale));
+            render(ig);
+        }
+
+        g.drawImage(image, juce::Rectangle<float>(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height)));
+    }
+
+    void invalidate() { image = juce::Image(); }
+
+private:
+    juce::Image image;
+    int cachedWidth = 0, cachedHeight = 0;
+    float cachedScale = 0.0f;
+};
@@ -0,0 +1,63 @@
+// LnfImageCache.h
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+// =======================================
+// Pre-rendered look-and-feel layers
+// Shared by every control through juce::SharedResourcePointer, so all knobs
+// of the same size blit one image. Message thread only.
+// =======================================
+class LnfImageCache
+{
+public:
+    enum Layer { knobBody = 0, sliderTrack, sliderThumb };
+
+    // Returns the layer for this size and display scale, rendering it on first use.
+    // render(g, area) draws the layer into area, in logical coordinates at (0, 0).
+    template <typename RenderFunction>
+    const juce::Image& get(Layer layer, int width, int height, float scale, RenderFunction&& render)
+    {
+        for (auto& entry : entries)
+            if (entry.layer == layer && entry.width == width && entry.height == height && entry.scale == scale)
+                return entry.image;
+
+        // Sizes only change while the editor is being resized; start over rather than grow
+        if (entries.size() >= maxEntries)
+            entries.clear();
+
+        juce::Image image(juce::Image::ARGB,
+            juce::jmax(1, juce::roundToInt(width * scale)),
+            juce::jmax(1, juce::roundToInt(height * scale)), true);
+
+        {
+            juce::Graphics g(image);
+            g.addTransform(juce::AffineTransform::scale(scale));
+            render(g, juce::Rectangle<float>(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height)));
+        }
+
+        entries.push_back({ layer, width, height, scale, image });
+        return entries.back().image;
+    }
+
+    // Draws a cached layer with its top-left corner at (x, y)
+    template <typename RenderFunction>
+    void draw(juce::Graphics& g, Layer layer, float x, float y, int width, int height, RenderFunction&& render)
+    {
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        g.drawImage(get(layer, width, height, scale, render),
+            juce::Rectangle<float>(x, y, static_cast<float>(width), static_cast<float>(height)));
+    }
+
+private:
+    struct Entry
+    {
+        Layer layer;
+        int width, height;
+        float scale;
+        juce::Image image;
+    };
+
+    static constexpr size_t maxEntries = 32;
+    std::vector<Entry> entries;
+};
@@ -3,68 +3,228 @@
 //==============================================================================
 // SmallLcdDisplay Implementation
 //==============================================================================
-SmallLcdDisplay::SmallLcdDisplay() {
+SmallLcdDisplay::SmallLcdDisplay()
+    : labelFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 10.0f, juce::Font::bold)),
+      valueFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 12.0f, juce::Font::plain)) {
     setSize(100, 40);
 }
 
 void SmallLcdDisplay::paint(juce::Graphics& g) {
+    DRMK_PROFILE_PAINT();
+
     // LCD background (vintage green backlight)
-    g.fillAll(juce::Colour(120, 140, 100));
-    g.setColour(juce::Colour(60, 70, 50));
-    g.drawRect(getLocalBounds(), 2);
+    background.draw(g, getWidth(), getHeight(), [this](juce::Graphics& bg) {
+        bg.fillAll(LcdColours::backlight);
+        bg.setColour(LcdColours::border);
+        bg.drawRect(getLocalBounds(), 2);
+    });
 
     // Dark text on green LCD
-    g.setColour(juce::Colour(20, 25, 15));
-
-    g.setFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 10.0f, juce::Font::bold));
-    g.drawText(label, 2, 2, getWidth() - 4, 14, juce::Justification::centred, false);
+    g.setColour(LcdColours::ink);
+    labelGlyphs.draw(g);
+    valueGlyphs.draw(g);
+}
 
-    g.setFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 12.0f, juce::Font::plain));
-    g.drawText(valueText, 2, 18, getWidth() - 4, 18, juce::Justification::centred, false);
+void SmallLcdDisplay::resized() {
+    layoutLabel();
+    layoutValue();
 }
 
 void SmallLcdDisplay::setLabel(const juce::String& text) {
-    label = text;
-    repaint();
+    if (label != text) {
+        label = text;
+        layoutLabel();
+        repaint(getLabelArea());
+    }
 }
 
 void SmallLcdDisplay::setValue(const juce::String& text) {
     if (valueText != text) {
         valueText = text;
-        repaint();
+        layoutValue();
+        repaint(getValueArea());
     }
 }
 
+void SmallLcdDisplay::layoutLabel() {
+    const auto area = getLabelArea().toFloat();
+    labelGlyphs.clear();
+    labelGlyphs.addFittedText(labelFont, label, area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+        juce::Justification::centred, 1, 1.0f);
+}
+
+void SmallLcdDisplay::layoutValue() {
+    const auto area = getValueArea().toFloat();
+    valueGlyphs.clear();
+    valueGlyphs.addFittedText(valueFont, valueText, area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+        juce::Justification::centred, 1, 1.0f);
+}
+
 //==============================================================================
 // MainLcdDisplay Implementation
 //==============================================================================
-MainLcdDisplay::MainLcdDisplay() {
+MainLcdDisplay::MainLcdDisplay()
+    : font(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 16.0f, juce::Font::bold)) {
     setSize(500, 80);
 }
 
+MainLcdDisplay::~MainLcdDisplay() {
+    setSpectrogramVisible(false);
+}
+
 void MainLcdDisplay::paint(juce::Graphics& g) {
+    DRMK_PROFILE_PAINT();
+
     // Vintage green LCD background
-    g.fillAll(juce::Colour(120, 140, 100));
-    g.setColour(juce::Colour(60, 70, 50));
-    g.drawRect(getLocalBounds(), 2);
+    background.draw(g, getWidth(), getHeight(), [this](juce::Graphics& bg) {
+        bg.fillAll(LcdColours::backlight);
+        bg.setColour(LcdColours::border);
+        bg.drawRect(getLocalBounds(), 2);
+    });
+
+    if (showSpectrogram) {
+        g.drawImageAt(spectrogram, getSpectrogramArea().getX(), getSpectrogramArea().getY());
+        return;
+    }
 
     // Display text
-    g.setColour(juce::Colour(20, 25, 15));
+    g.setColour(LcdColours::ink);
 
-    g.setFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 16.0f, juce::Font::bold));
+    for (auto& glyphs : lineGlyphs) {
+        glyphs.draw(g);
+    }
+}
 
+void MainLcdDisplay::resized() {
     for (int i = 0; i < 4; ++i) {
-        g.drawText(lines[i], 5, 2 + i * 18, getWidth() - 10, 18, juce::Justification::left, false);
+        layoutLine(i);
+    }
+
+    if (showSpectrogram) {
+        const auto area = getSpectrogramArea();
+        spectrogram = juce::Image(juce::Image::RGB, juce::jmax(1, area.getWidth()), juce::jmax(1, area.getHeight()), false);
+        spectrogram.clear(spectrogram.getBounds(), LcdColours::backlight);
     }
 }
 
 void MainLcdDisplay::setText(const juce::String& text, int line) {
     if (line >= 0 && line < 4 && lines[line] != text) {
         lines[line] = text;
-        repaint();
+        layoutLine(line);
+        repaint(getLineArea(line));
     }
 }
 
+void MainLcdDisplay::setTailAnalyser(TailAnalyser* analyser) {
+    setSpectrogramVisible(false);
+    tailAnalyser = analyser;
+}
+
+void MainLcdDisplay::mouseDown(const juce::MouseEvent&) {
+    setSpectrogramVisible(!showSpectrogram);
+}
+
+void MainLcdDisplay::setSpectrogramVisible(bool shouldShow) {
+    if (tailAnalyser == nullptr || shouldShow == showSpectrogram) return;
+
+    showSpectrogram = shouldShow;
+
+    // The analyser thread only runs while the spectrogram is on screen
+    if (showSpectrogram) {
+        resized();
+        tailAnalyser->start();
+        spectrogramVBlank = std::make_unique<juce::VBlankAttachment>(this, [this] { pullSpectrogramColumns(); });
+    }
+    else {
+        spectrogramVBlank.reset();
+        tailAnalyser->stop();
+        spectrogram = juce::Image();
+    }
+
+    repaint();
+}
+
+void MainLcdDisplay::pullSpectrogramColumns() {
+    const int width = spectrogram.getWidth();
+    const int height = spectrogram.getHeight();
+    int numNew = 0;
+
+    TailAnalyser::Column column;
+    while (tailAnalyser->popColumn(column)) {
+        // Scroll left by one pixel per analysis frame, newest column on the right
+        spectrogram.moveImageSection(0, 0, 1, 0, width - 1, height);
+
+        juce::Graphics g(spectrogram);
+        for (int band = 0; band < TailAnalyser::numBands; ++band) {
+            // Lowest band at the bottom; darker ink means more energy
+            const int top = height - (band + 1) * height / TailAnalyser::numBands;
+            const int bottom = height - band * height / TailAnalyser::numBands;
+            const float level = juce::jlimit(0.0f, 1.0f, 1.0f - column[static_cast<size_t>(band)] / TailAnalyser::minDb);
+
+            g.setColour(LcdColours::backlight.interpolatedWith(LcdColours::ink, level));
+            g.fillRect(width - 1, top, 1, bottom - top);
+        }
+        ++numNew;
+    }
+
+    if (numNew > 0) {
+        repaint(getSpectrogramArea());
+    }
+}
+
+void MainLcdDisplay::layoutLine(int line) {
+    const auto area = getLineArea(line).toFloat();
+    lineGlyphs[line].clear();
+    lineGlyphs[line].addFittedText(font, lines[line], area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+        juce::Justification::left, 1, 1.0f);
+}
+
+//==============================================================================
+// DisplayUpdateScheduler Implementation
+//==============================================================================
+ScheduledDisplay::~ScheduledDisplay() {
+    if (scheduler != nullptr) scheduler->remove(*this);
+}
+
+void ScheduledDisplay::setScheduler(DisplayUpdateScheduler* newScheduler) {
+    if (scheduler != nullptr) scheduler->remove(*this);
+    scheduler = newScheduler;
+}
+
+void ScheduledDisplay::requestDisplayUpdate() {
+    if (scheduler != nullptr) scheduler->markDirty(*this);
+    else refreshDisplay();
+}
+
+DisplayUpdateScheduler::DisplayUpdateScheduler(juce::Component& owner)
+    : vBlank(&owner, [this] { flush(); }) {
+    dirtyDisplays.reserve(32);
+}
+
+void DisplayUpdateScheduler::markDirty(ScheduledDisplay& display) {
+    if (!display.displayDirty) {
+        display.displayDirty = true;
+        dirtyDisplays.push_back(&display);
+    }
+}
+
+void DisplayUpdateScheduler::remove(ScheduledDisplay& display) {
+    if (display.displayDirty) {
+        display.displayDirty = false;
+        dirtyDisplays.erase(std::remove(dirtyDisplays.begin(), dirtyDisplays.end(), &display), dirtyDisplays.end());
+    }
+}
+
+void DisplayUpdateScheduler::flush() {
+    // Each display converts its value to text once, however many changes arrived
+    for (size_t i = 0; i < dirtyDisplays.size(); ++i) {
+        auto* display = dirtyDisplays[i];
+        display->displayDirty = false;
+        display->refreshDisplay();
+    }
+    dirtyDisplays.clear();
+}
+
 //==============================================================================
 // ParameterKnobWithLcd Implementation
 //==============================================================================
@@ -78,7 +238,7 @@ ParameterKnobWithLcd::ParameterKnobWithLcd() : parameter(nullptr) {
     knob.setRange(0.0, 1.0, 0.01);
     knob.setValue(0.5);
     knob.setDoubleClickReturnValue(true, 0.5);
-    knob.onValueChange = [this] { updateLcdValue(); };
+    knob.onValueChange = [this] { requestDisplayUpdate(); };
 
     addAndMakeVisible(knob);
     addAndMakeVisible(lcd);
@@ -94,15 +254,14 @@ void ParameterKnobWithLcd::attachParameter(juce::AudioProcessorValueTreeState& a
     const juce::String& paramID,
     const juce::String& lbl,
     const juce::String& unit) {
-    parameter = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramID));
+    parameter = apvts.getParameter(paramID);
     paramLabel = lbl;
     paramUnit = unit;
 
     if (parameter != nullptr) {
-        knob.setRange(parameter->range.start,
-            parameter->range.end,
-            parameter->range.interval);
-        knob.setValue(parameter->get(), juce::dontSendNotification);
+        const auto& range = parameter->getNormalisableRange();
+        knob.setRange(range.start, range.end, range.interval);
+        knob.setValue(parameter->convertFrom0to1(parameter->getValue()), juce::dontSendNotification);
     }
 
     attachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
@@ -144,6 +303,7 @@ void ParameterKnobWithLcd::updateLcdValue() {
     else if (paramUnit == "ms") display = juce::String(value, 0) + "ms";
     else if (paramUnit == "%") display = juce::String(value * 100, 0) + "%";
     else if (paramUnit == "x") display = juce::String(value, 2) + "x";
+    else if (paramUnit == "choice") display = parameter->getText(parameter->convertTo0to1(value), 0).toUpperCase();
     else display = juce::String(value, 2);
 
     lcd.setValue(display);
@@ -213,7 +373,7 @@ void MixSliderWithLcd::resized() {
 
 void MixSliderWithLcd::sliderValueChanged(juce::Slider* changedSlider) {
     if (changedSlider == &slider) {
-        updateDisplay();
+        requestDisplayUpdate();
     }
 }
 
@@ -255,6 +415,7 @@ DSP256XLReverbEditor::DSP256XLReverbEditor(DSP256XLReverbProcessor& p)
 
     // Setup main LCD
     addAndMakeVisible(mainLcd);
+    mainLcd.setTailAnalyser(&processor.getTailAnalyser());
     mainLcd.setText("DSP-256XL DIGITAL REVERB", 0);
     mainLcd.setText("Schroeder Architecture", 1);
     mainLcd.setText("8 Combs + 4 Allpasses", 2);
@@ -262,16 +423,35 @@ DSP256XLReverbEditor::DSP256XLReverbEditor(DSP256XLReverbProcessor& p)
 
     // Setup mix slider with LCD
     addAndMakeVisible(mixSlider);
+    mixSlider.setScheduler(&displayScheduler);
     mixSlider.attachParameter(processor.getAPVTS(), "mix");
 
     // Create all knobs
     createKnobs();
 
+    // Dual-core processing is a processor option saved with the state
+    dualCoreButton.setColour(juce::ToggleButton::textColourId, juce::Colour(180, 180, 185));
+    dualCoreButton.setColour(juce::ToggleButton::tickColourId, LcdColours::backlight);
+    dualCoreButton.setToggleState(processor.isDualCoreProcessing(), juce::dontSendNotification);
+    dualCoreButton.onClick = [this] {
+        processor.setDualCoreProcessing(dualCoreButton.getToggleState());
+        dualCoreButton.setToggleState(processor.isDualCoreProcessing(), juce::dontSendNotification);
+    };
+    addAndMakeVisible(dualCoreButton);
+
     // Call resized() immediately
     resized();
+
+#if DRMK_ENABLE_PROFILING
+    startTimerHz(4);
+#endif
 }
 
 DSP256XLReverbEditor::~DSP256XLReverbEditor() {
+#if DRMK_ENABLE_PROFILING
+    stopTimer();
+#endif
+
     for (auto& knob : knobs) {
         if (knob) {
             knob.reset();
@@ -280,7 +460,7 @@ DSP256XLReverbEditor::~DSP256XLReverbEditor() {
 }
 
 void DSP256XLReverbEditor::createKnobs() {
-    // 3 rows, 5 knobs each = 15 parameters total
+    // 5 knobs per row; the last row holds the band decay controls
     struct ParamInfo {
         juce::String id, label, unit;
     };
@@ -305,20 +485,54 @@ void DSP256XLReverbEditor::createKnobs() {
         {"subdelay", "TAIL-DLY", "x"},
         {"sublevel", "TAIL", "%"},
         {"envelop", "ENVLP", "%"},
-        {"tielevel", "HF", "%"}
+        {"tielevel", "HF", "%"},
+
+        // Row 4: Band Decay & Ducking
+        {"lowdecay", "LO-DCY", "x"},
+        {"highdecay", "HI-DCY", "x"},
+        {"duck", "DUCK", "%"},
+        {"duckatk", "DK-ATK", "ms"},
+        {"duckrel", "DK-REL", "ms"},
+
+        // Row 5: Input Diffusion, Modes & Quality, then the freeze button
+        {"inputdiff", "IN-DIFF", "%"},
+        {"mode", "MODE", "choice"},
+        {"gatelen", "GATE", "ms"},
+        {"quality", "QUALITY", "choice"}
     };
 
+    jassert(static_cast<int>(params.size()) == numKnobs);
+
     for (size_t i = 0; i < params.size(); ++i) {
         knobs[i] = std::make_unique<ParameterKnobWithLcd>();
+        knobs[i]->setScheduler(&displayScheduler);
         knobs[i]->attachParameter(processor.getAPVTS(),
             params[i].id,
             params[i].label,
             params[i].unit);
         addAndMakeVisible(*knobs[i]);
     }
+
+    freezeButton.setColour(juce::ToggleButton::textColourId, juce::Colour(200, 200, 200));
+    freezeButton.setColour(juce::ToggleButton::tickColourId, LcdColours::backlight);
+    freezeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        processor.getAPVTS(), "freeze", freezeButton);
+    addAndMakeVisible(freezeButton);
+}
+
+#if DRMK_ENABLE_PROFILING
+void DSP256XLReverbEditor::timerCallback() {
+    if (processor.isDualCoreProcessing()) {
+        mainLcd.setText(processor.getLateNetworkHelper().getSummary(), 1);
+    }
+    mainLcd.setText(GuiPaintProfiler::getInstance().takeSummary(), 2);
+    mainLcd.setText(processor.getProfiler().getSummary(), 3);
 }
+#endif
 
 void DSP256XLReverbEditor::paint(juce::Graphics& g) {
+    DRMK_PROFILE_PAINT();
+
     // Brushed aluminum background
     juce::ColourGradient bgGrad(
         juce::Colour(85, 85, 90), 0.0f, 0.0f,
@@ -355,9 +569,10 @@ void DSP256XLReverbEditor::resized() {
     // Calculate proportional sizes based on current height
     float scale = static_cast<float>(getHeight()) / 800.0f; // 800 is max height
 
-    // Title area (proportional)
+    // Title area (proportional), with the dual-core option in its corner
     int titleHeight = static_cast<int>(80 * scale);
-    area.removeFromTop(titleHeight);
+    auto titleArea = area.removeFromTop(titleHeight);
+    dualCoreButton.setBounds(titleArea.removeFromRight(100).removeFromTop(30).reduced(5));
 
     // Main LCD (proportional)
     int lcdHeight = static_cast<int>(90 * scale);
@@ -377,26 +592,18 @@ void DSP256XLReverbEditor::resized() {
     // Spacing under mix slider (proportional)
     area.removeFromTop(static_cast<int>(15 * scale));
 
-    // Calculate available space for 3 rows of knobs
+    // Calculate available space for the rows of knobs
+    const int numRows = (numKnobs + knobsPerRow - 1) / knobsPerRow;
     int availableHeight = area.getHeight() - static_cast<int>(30 * scale); // Leave space for bottom text
     int rowSpacing = static_cast<int>(15 * scale);
-    int rowHeight = (availableHeight - 2 * rowSpacing) / 3; // Divide equally among 3 rows
+    int rowHeight = (availableHeight - (numRows - 1) * rowSpacing) / numRows; // Divide equally among rows
 
     int margin = static_cast<int>(30 * scale);
 
-    // Row 1: 5 knobs
-    auto row1 = area.removeFromTop(rowHeight);
-    layoutKnobRow(row1, 0, 5, margin);
-    area.removeFromTop(rowSpacing);
-
-    // Row 2: 5 knobs
-    auto row2 = area.removeFromTop(rowHeight);
-    layoutKnobRow(row2, 5, 5, margin);
-    area.removeFromTop(rowSpacing);
-
-    // Row 3: 5 knobs
-    auto row3 = area.removeFromTop(rowHeight);
-    layoutKnobRow(row3, 10, 5, margin);
+    for (int row = 0; row < numRows; ++row) {
+        layoutKnobRow(area.removeFromTop(rowHeight), row * knobsPerRow, knobsPerRow, margin);
+        area.removeFromTop(rowSpacing);
+    }
 }
 
 void DSP256XLReverbEditor::layoutKnobRow(juce::Rectangle<int> area, int startIdx, int count, int margin) {
@@ -406,10 +613,16 @@ void DSP256XLReverbEditor::layoutKnobRow(juce::Rectangle<int> area, int startIdx
 
     for (int i = 0; i < count; ++i) {
         int idx = startIdx + i;
-        if (idx < 15 && knobs[idx]) {
+        if (idx < numKnobs && knobs[idx]) {
             int x = margin + i * knobWidth + (i > 0 ? spacing / 2 : 0);
             int width = knobWidth - spacing;
             knobs[idx]->setBounds(x, area.getY(), width, area.getHeight());
         }
+        else if (idx == numKnobs) {
+            int x = margin + i * knobWidth + (i > 0 ? spacing / 2 : 0);
+            int width = knobWidth - spacing;
+            freezeButton.setBounds(juce::Rectangle<int>(x, area.getY(), width, area.getHeight())
+                .withSizeKeepingCentre(juce::jmin(width, 100), 30));
+        }
     }
 }
\ No newline at end of file
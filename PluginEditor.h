@@ -4,6 +4,7 @@
 #include "BlackMetalKnobLNF.h"
 #include "BlackMetalSliderLNF.h"
 #include "ThinBlockLcdDisplay.h" 
+#include "LcdRenderCache.h"
 
 //==============================================================================
 // Small LCD Display (Vintage Green)
@@ -12,11 +13,23 @@ class SmallLcdDisplay : public juce::Component {
 public:
     SmallLcdDisplay();
     void paint(juce::Graphics& g) override;
+    void resized() override;
     void setLabel(const juce::String& text);
     void setValue(const juce::String& text);
 
 private:
     juce::String label, valueText;
+
+    // Fonts and glyph layouts are built once per text change, not per paint
+    juce::Font labelFont, valueFont;
+    juce::GlyphArrangement labelGlyphs, valueGlyphs;
+    LcdBackgroundCache background;
+
+    juce::Rectangle<int> getLabelArea() const { return { 2, 2, getWidth() - 4, 14 }; }
+    juce::Rectangle<int> getValueArea() const { return { 2, 18, getWidth() - 4, 18 }; }
+    void layoutLabel();
+    void layoutValue();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SmallLcdDisplay)
 };
 
@@ -26,18 +39,83 @@ private:
 class MainLcdDisplay : public juce::Component {
 public:
     MainLcdDisplay();
+    ~MainLcdDisplay() override;
     void paint(juce::Graphics& g) override;
+    void resized() override;
     void setText(const juce::String& text, int line);
 
+    // Clicking the display toggles between the text lines and a scrolling
+    // decay spectrogram of the wet signal
+    void setTailAnalyser(TailAnalyser* analyser);
+    void mouseDown(const juce::MouseEvent& e) override;
+
 private:
     juce::String lines[4];
+
+    juce::Font font;
+    juce::GlyphArrangement lineGlyphs[4];
+    LcdBackgroundCache background;
+
+    juce::Rectangle<int> getLineArea(int line) const { return { 5, 2 + line * 18, getWidth() - 10, 18 }; }
+    void layoutLine(int line);
+
+    TailAnalyser* tailAnalyser = nullptr;
+    bool showSpectrogram = false;
+    juce::Image spectrogram;
+    std::unique_ptr<juce::VBlankAttachment> spectrogramVBlank;
+
+    juce::Rectangle<int> getSpectrogramArea() const { return getLocalBounds().reduced(2); }
+    void setSpectrogramVisible(bool shouldShow);
+    void pullSpectrogramColumns();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainLcdDisplay)
 };
 
+//==============================================================================
+// Display Update Scheduler
+// Parameter changes only mark a display dirty; dirty displays are refreshed
+// together once per display frame, however often the host automates them.
+//==============================================================================
+class DisplayUpdateScheduler;
+
+class ScheduledDisplay {
+public:
+    virtual ~ScheduledDisplay();
+
+    // Refreshes the display at once without a scheduler, otherwise on the next frame
+    void setScheduler(DisplayUpdateScheduler* newScheduler);
+    void requestDisplayUpdate();
+
+protected:
+    virtual void refreshDisplay() = 0;
+
+private:
+    friend class DisplayUpdateScheduler;
+    DisplayUpdateScheduler* scheduler = nullptr;
+    bool displayDirty = false;
+};
+
+class DisplayUpdateScheduler {
+public:
+    explicit DisplayUpdateScheduler(juce::Component& owner);
+
+    void markDirty(ScheduledDisplay& display);
+    void remove(ScheduledDisplay& display);
+
+private:
+    void flush();
+
+    std::vector<ScheduledDisplay*> dirtyDisplays;
+    juce::VBlankAttachment vBlank;
+
+    JUCE_DECLARE_NON_COPYABLE(DisplayUpdateScheduler)
+};
+
 //==============================================================================
 // Parameter Knob with LCD
 //==============================================================================
-class ParameterKnobWithLcd : public juce::Component {
+class ParameterKnobWithLcd : public juce::Component,
+    public ScheduledDisplay {
 public:
     ParameterKnobWithLcd();
     ~ParameterKnobWithLcd() override;
@@ -54,11 +132,12 @@ private:
     juce::Slider knob;
     SmallLcdDisplay lcd;
     BlackMetalKnobLNF blackMetalLNF;
-    juce::AudioParameterFloat* parameter;
+    juce::RangedAudioParameter* parameter;
     juce::String paramLabel, paramUnit;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attachment;
 
     void updateLcdValue();
+    void refreshDisplay() override { updateLcdValue(); }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterKnobWithLcd)
 };
@@ -67,7 +146,8 @@ private:
 // Mix Slider Component WITH LCD Display
 //==============================================================================
 class MixSliderWithLcd : public juce::Component,
-    public juce::Slider::Listener {
+    public juce::Slider::Listener,
+    public ScheduledDisplay {
 public:
     MixSliderWithLcd();
     ~MixSliderWithLcd() override;
@@ -87,13 +167,19 @@ private:
     ThinBlockLcdDisplay lcdDisplay;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attachment;
 
+    void refreshDisplay() override { updateDisplay(); }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MixSliderWithLcd)
 };
 
 //==============================================================================
 // Main Plugin Editor
 //==============================================================================
-class DSP256XLReverbEditor : public juce::AudioProcessorEditor {
+class DSP256XLReverbEditor : public juce::AudioProcessorEditor
+#if DRMK_ENABLE_PROFILING
+    , private juce::Timer
+#endif
+{
 public:
     explicit DSP256XLReverbEditor(DSP256XLReverbProcessor& p);
     ~DSP256XLReverbEditor() override;
@@ -103,16 +189,34 @@ public:
 
 private:
     DSP256XLReverbProcessor& processor;
+
+    // Declared before the displays it refreshes so it outlives them
+    DisplayUpdateScheduler displayScheduler{ *this };
+
     MainLcdDisplay mainLcd;
 
     // Mix slider with LCD display
     MixSliderWithLcd mixSlider;
 
-    // 3 rows of knobs
-    std::unique_ptr<ParameterKnobWithLcd> knobs[15];
+    // Rows of knobs, knobsPerRow to a row
+    static constexpr int numKnobs = 24;
+    static constexpr int knobsPerRow = 5;
+    std::unique_ptr<ParameterKnobWithLcd> knobs[numKnobs];
+
+    // Freeze is on or off, so it takes the slot after the last knob
+    juce::ToggleButton freezeButton{ "FREEZE" };
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> freezeAttachment;
+
+    // Runs the right channel's late network on a second core (not automatable)
+    juce::ToggleButton dualCoreButton{ "2 CPU" };
 
     void layoutKnobRow(juce::Rectangle<int> area, int startIdx, int count, int margin);
     void createKnobs();
 
+#if DRMK_ENABLE_PROFILING
+    // Shows the processor's CPU summary on the last LCD line
+    void timerCallback() override;
+#endif
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DSP256XLReverbEditor)
 };
\ No newline at end of file
@@ -5,51 +5,62 @@
 // OnePole Implementation (Enhanced)
 //==============================================================================
 
-OnePole::OnePole() : state(0.0f) {}
+template <typename SampleType>
+OnePole<SampleType>::OnePole() : state(0) {}
 
-float OnePole::process(float input, float coeff) {
-    coeff = juce::jlimit(0.0f, 0.9999f, coeff);
-    state = input * (1.0f - coeff) + state * coeff;
+template <typename SampleType>
+SampleType OnePole<SampleType>::process(SampleType input, SampleType coeff) {
+    coeff = juce::jlimit(SampleType(0), SampleType(0.9999f), coeff);
+    state = input * (SampleType(1) - coeff) + state * coeff;
     return state;
 }
 
-void OnePole::reset() { state = 0.0f; }
-void OnePole::clear() { state = 0.0f; }
+template <typename SampleType>
+void OnePole<SampleType>::reset() { state = 0; }
+template <typename SampleType>
+void OnePole<SampleType>::clear() { state = 0; }
 
 //==============================================================================
 // DampingFilter Implementation
 //==============================================================================
 
-DampingFilter::DampingFilter() : lpState(0.0f), hpState(0.0f), lpCoeff(0.5f), hpCoeff(0.8f) {}
+template <typename SampleType>
+DampingFilter<SampleType>::DampingFilter() : lpState(0), hpState(0), lpCoeff(SampleType(0.5f)), hpCoeff(SampleType(0.8f)) {}
 
-void DampingFilter::setCoeffs(float lpCoeff, float hpCoeff) {
-    this->lpCoeff = juce::jlimit(0.0f, 0.999f, lpCoeff);
-    this->hpCoeff = juce::jlimit(0.01f, 0.999f, hpCoeff);
+template <typename SampleType>
+void DampingFilter<SampleType>::setCoeffs(SampleType lpCoeff, SampleType hpCoeff) {
+    this->lpCoeff = juce::jlimit(SampleType(0), SampleType(0.999f), lpCoeff);
+    this->hpCoeff = juce::jlimit(SampleType(0.01f), SampleType(0.999f), hpCoeff);
 }
 
-float DampingFilter::process(float input) {
+template <typename SampleType>
+SampleType DampingFilter<SampleType>::process(SampleType input) {
     // Multi-stage damping for frequency-dependent decay
-    float stage1 = input * (1.0f - lpCoeff) + lpState * lpCoeff;
+    SampleType stage1 = input * (SampleType(1) - lpCoeff) + lpState * lpCoeff;
     lpState = stage1;
 
     // High-frequency emphasis
-    float stage2 = stage1 - hpState;
-    hpState = stage1 * hpCoeff + hpState * (1.0f - hpCoeff);
+    SampleType stage2 = stage1 - hpState;
+    hpState = stage1 * hpCoeff + hpState * (SampleType(1) - hpCoeff);
 
-    return stage1 + stage2 * 0.3f;  // Mix of damped and emphasized
+    return stage1 + stage2 * SampleType(0.3f);  // Mix of damped and emphasized
 }
 
-void DampingFilter::clear() {
-    lpState = hpState = 0.0f;
+template <typename SampleType>
+void DampingFilter<SampleType>::clear() {
+    lpState = hpState = 0;
 }
 
 //==============================================================================
 // EnhancedCombFilter Implementation
 //==============================================================================
 
-EnhancedCombFilter::EnhancedCombFilter() : writeIndex(0), feedback(0.5f), dampingLP(0.5f), dampingHP(0.8f) {}
+template <typename SampleType>
+EnhancedCombFilter<SampleType>::EnhancedCombFilter()
+    : writeIndex(0), feedback(SampleType(0.5f)), dampingLP(SampleType(0.5f)), dampingHP(SampleType(0.8f)) {}
 
-void EnhancedCombFilter::setSize(int samples) {
+template <typename SampleType>
+void EnhancedCombFilter<SampleType>::setSize(int samples) {
     if (samples <= 0) {
         DBG("ERROR: EnhancedCombFilter::setSize called with invalid size: " << samples);
         samples = 1;
@@ -59,19 +70,20 @@ void EnhancedCombFilter::setSize(int samples) {
     writeIndex = 0;
 }
 
-float EnhancedCombFilter::process(float input, float stereoSpread) {
+template <typename SampleType>
+SampleType EnhancedCombFilter<SampleType>::process(SampleType input, SampleType stereoSpread) {
     if (buffer.empty()) return input;
 
     if (writeIndex >= static_cast<int>(buffer.size())) {
         writeIndex = 0;
     }
 
-    float output = buffer[writeIndex];
-    float damped = damping.process(output);
+    SampleType output = buffer[writeIndex];
+    SampleType damped = damping.process(output);
 
     // Stereo detuning for width
-    float spreadMod = 1.0f + (stereoSpread * 0.01f);
-    float safeFeedback = juce::jlimit(0.0f, 0.999f, feedback * spreadMod);
+    SampleType spreadMod = SampleType(1) + (stereoSpread * SampleType(0.01f));
+    SampleType safeFeedback = juce::jlimit(SampleType(0), SampleType(0.999f), feedback * spreadMod);
 
     buffer[writeIndex] = input + damped * safeFeedback;
     writeIndex = (writeIndex + 1) % static_cast<int>(buffer.size());
@@ -79,18 +91,21 @@ float EnhancedCombFilter::process(float input, float stereoSpread) {
     return output;
 }
 
-void EnhancedCombFilter::setDamping(float lpVal, float hpVal) {
-    dampingLP = juce::jlimit(0.0f, 0.999f, lpVal);
-    dampingHP = juce::jlimit(0.01f, 0.999f, hpVal);
+template <typename SampleType>
+void EnhancedCombFilter<SampleType>::setDamping(SampleType lpVal, SampleType hpVal) {
+    dampingLP = juce::jlimit(SampleType(0), SampleType(0.999f), lpVal);
+    dampingHP = juce::jlimit(SampleType(0.01f), SampleType(0.999f), hpVal);
     damping.setCoeffs(dampingLP, dampingHP);
 }
 
-void EnhancedCombFilter::setFeedback(float val) {
-    feedback = juce::jlimit(0.0f, 0.999f, val);
+template <typename SampleType>
+void EnhancedCombFilter<SampleType>::setFeedback(SampleType val) {
+    feedback = juce::jlimit(SampleType(0), SampleType(0.999f), val);
 }
 
-void EnhancedCombFilter::clear() {
-    std::fill(buffer.begin(), buffer.end(), 0.0f);
+template <typename SampleType>
+void EnhancedCombFilter<SampleType>::clear() {
+    std::fill(buffer.begin(), buffer.end(), SampleType(0));
     damping.clear();
 }
 
@@ -98,9 +113,13 @@ void EnhancedCombFilter::clear() {
 // Original CombFilter Implementation (kept for compatibility)
 //==============================================================================
 
-CombFilter::CombFilter() : writeIndex(0), damp(0.5f), feedback(0.5f) {}
+template <typename SampleType>
+CombFilter<SampleType>::CombFilter() : writeIndex(0), damp(SampleType(0.5f)), feedback(SampleType(0.5f)) {
+    updateLoop();
+}
 
-void CombFilter::setSize(int samples) {
+template <typename SampleType>
+void CombFilter<SampleType>::setSize(int samples) {
     if (samples <= 0) {
         DBG("ERROR: CombFilter::setSize called with invalid size: " << samples);
         samples = 1;
@@ -110,42 +129,109 @@ void CombFilter::setSize(int samples) {
     writeIndex = 0;
 }
 
-float CombFilter::process(float input) {
+template <typename SampleType>
+void CombFilter<SampleType>::reserve(int samples) {
+    buffer.reserve(static_cast<size_t>(juce::jmax(1, samples)));
+}
+
+template <typename SampleType>
+SampleType CombFilter<SampleType>::process(SampleType input) {
     if (buffer.empty()) return input;
 
     if (writeIndex >= static_cast<int>(buffer.size())) {
         writeIndex = 0;
     }
 
-    float output = buffer[writeIndex];
-    float damped = lowpass.process(output, damp);
+    SampleType output = buffer[writeIndex];
+    SampleType damped = lowpass.process(output, loopDamp);
 
-    float safeFeedback = juce::jlimit(0.0f, 0.9999f, feedback);
-    buffer[writeIndex] = input + damped * safeFeedback;
+    if (shelving) {
+        // Low band scaled by lowShelfGain, band above the high crossover by highShelfGain
+        const SampleType low = lowShelf.process(damped, lowShelfCoeff);
+        const SampleType belowHigh = highShelf.process(damped, highShelfCoeff);
+        damped += (loopLowGain - SampleType(1)) * low + (loopHighGain - SampleType(1)) * (damped - belowHigh);
+    }
+
+    buffer[writeIndex] = input + damped * loopFeedback;
     writeIndex = (writeIndex + 1) % static_cast<int>(buffer.size());
     return output;
 }
 
-void CombFilter::setDamp(float val) {
-    damp = juce::jlimit(0.0f, 0.9999f, val);
+template <typename SampleType>
+void CombFilter<SampleType>::setDamp(SampleType val) {
+    damp = juce::jlimit(SampleType(0), SampleType(0.9999f), val);
+    updateLoop();
+}
+
+template <typename SampleType>
+void CombFilter<SampleType>::setFeedback(SampleType val) {
+    feedback = juce::jlimit(SampleType(0), SampleType(0.9999f), val);
+    updateLoop();
 }
 
-void CombFilter::setFeedback(float val) {
-    feedback = juce::jlimit(0.0f, 0.9999f, val);
+template <typename SampleType>
+void CombFilter<SampleType>::setShelves(SampleType lowCoeff, SampleType highCoeff, SampleType lowGain, SampleType highGain) {
+    lowShelfCoeff = lowCoeff;
+    highShelfCoeff = highCoeff;
+    lowShelfGain = lowGain;
+    highShelfGain = highGain;
+    updateLoop();
+}
+
+template <typename SampleType>
+void CombFilter<SampleType>::setFreeze(SampleType amount) {
+    freeze = juce::jlimit(SampleType(0), SampleType(1), amount);
+    updateLoop();
+}
+
+template <typename SampleType>
+void CombFilter<SampleType>::updateLoop() {
+    // Written so freeze 0 gives exactly the plain coefficients and freeze 1
+    // exactly unity feedback, no damping and flat shelves
+    const SampleType thaw = SampleType(1) - freeze;
+    loopFeedback = juce::jlimit(SampleType(0), SampleType(1), feedback * thaw + freeze);
+    loopDamp = damp * thaw;
+
+    // In between, each band's total loop gain (feedback times shelf) moves to
+    // unity, staying below it until freeze 1. Blending the two factors
+    // separately would take a band whose shelf is above 1 past unity mid-ramp.
+    if (freeze > SampleType(0)) {
+        const SampleType maxLoopGain(0.9999f);
+        loopLowGain = (juce::jmin(maxLoopGain, feedback * lowShelfGain) * thaw + freeze) / loopFeedback;
+        loopHighGain = (juce::jmin(maxLoopGain, feedback * highShelfGain) * thaw + freeze) / loopFeedback;
+    }
+    else {
+        loopLowGain = lowShelfGain;
+        loopHighGain = highShelfGain;
+    }
+
+    const bool wasShelving = shelving;
+    shelving = loopLowGain != SampleType(1) || loopHighGain != SampleType(1);
+
+    // Don't let stale shelf state leak in when the shelves come back on
+    if (shelving && !wasShelving) {
+        lowShelf.clear();
+        highShelf.clear();
+    }
 }
 
-void CombFilter::clear() {
-    std::fill(buffer.begin(), buffer.end(), 0.0f);
+template <typename SampleType>
+void CombFilter<SampleType>::clear() {
+    std::fill(buffer.begin(), buffer.end(), SampleType(0));
     lowpass.clear();
+    lowShelf.clear();
+    highShelf.clear();
 }
 
 //==============================================================================
 // AllpassFilter Implementation
 //==============================================================================
 
-AllpassFilter::AllpassFilter() : writeIndex(0), coeff(0.5f) {}
+template <typename SampleType>
+AllpassFilter<SampleType>::AllpassFilter() : writeIndex(0), coeff(SampleType(0.5f)) {}
 
-void AllpassFilter::setSize(int samples) {
+template <typename SampleType>
+void AllpassFilter<SampleType>::setSize(int samples) {
     if (samples <= 0) {
         DBG("ERROR: AllpassFilter::setSize called with invalid size: " << samples);
         samples = 1;
@@ -155,36 +241,171 @@ void AllpassFilter::setSize(int samples) {
     writeIndex = 0;
 }
 
-float AllpassFilter::process(float input) {
+template <typename SampleType>
+void AllpassFilter<SampleType>::reserve(int samples) {
+    buffer.reserve(static_cast<size_t>(juce::jmax(1, samples)));
+}
+
+template <typename SampleType>
+SampleType AllpassFilter<SampleType>::process(SampleType input) {
     if (buffer.empty()) return input;
 
     if (writeIndex >= static_cast<int>(buffer.size())) {
         writeIndex = 0;
     }
 
-    float bufOut = buffer[writeIndex];
-    float safeCoeff = juce::jlimit(0.0f, 0.9999f, coeff);
-    float output = -input + bufOut;
+    SampleType bufOut = buffer[writeIndex];
+    SampleType safeCoeff = juce::jlimit(SampleType(0), SampleType(0.9999f), coeff);
+    SampleType output = -input + bufOut;
     buffer[writeIndex] = input + bufOut * safeCoeff;
     writeIndex = (writeIndex + 1) % static_cast<int>(buffer.size());
     return output;
 }
 
-void AllpassFilter::setCoeff(float val) {
-    coeff = juce::jlimit(0.0f, 0.9999f, val);
+template <typename SampleType>
+void AllpassFilter<SampleType>::setCoeff(SampleType val) {
+    coeff = juce::jlimit(SampleType(0), SampleType(0.9999f), val);
+}
+
+template <typename SampleType>
+void AllpassFilter<SampleType>::clear() {
+    std::fill(buffer.begin(), buffer.end(), SampleType(0));
+}
+
+//==============================================================================
+// AllpassCascade Implementation
+//==============================================================================
+
+template <typename SampleType>
+void AllpassCascade<SampleType>::setNumStages(int num) {
+    numStages = juce::jlimit(0, maxStages, num);
+
+    for (int s = 0; s < numStages; ++s) {
+        if (stages[static_cast<size_t>(s)].outer.buffer.empty()) {
+            resize(stages[static_cast<size_t>(s)].outer, 1);
+        }
+    }
+}
+
+template <typename SampleType>
+void AllpassCascade<SampleType>::resize(Line& line, int samples) {
+    if (samples <= 0) {
+        DBG("ERROR: AllpassCascade stage resized to invalid size: " << samples);
+        samples = 1;
+    }
+    line.buffer.resize(static_cast<size_t>(samples));
+    std::fill(line.buffer.begin(), line.buffer.end(), SampleType(0));
+    line.index = 0;
+}
+
+template <typename SampleType>
+void AllpassCascade<SampleType>::setSize(int stage, int samples) {
+    jassert(juce::isPositiveAndBelow(stage, numStages));
+    resize(stages[static_cast<size_t>(stage)].outer, samples);
+}
+
+template <typename SampleType>
+void AllpassCascade<SampleType>::reserve(int stage, int samples) {
+    stages[static_cast<size_t>(stage)].outer.buffer.reserve(static_cast<size_t>(juce::jmax(1, samples)));
+}
+
+template <typename SampleType>
+void AllpassCascade<SampleType>::setCoeff(int stage, SampleType val) {
+    stages[static_cast<size_t>(stage)].coeff = juce::jlimit(SampleType(0), SampleType(0.9999f), val);
+}
+
+template <typename SampleType>
+void AllpassCascade<SampleType>::setNestedSize(int stage, int samples) {
+    auto& s = stages[static_cast<size_t>(stage)];
+    s.nested = samples > 0;
+
+    if (s.nested) {
+        resize(s.inner, samples);
+    }
+    else {
+        s.inner.buffer.clear();
+        s.inner.index = 0;
+    }
+}
+
+template <typename SampleType>
+size_t AllpassCascade<SampleType>::getMemoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& s : stages) {
+        bytes += (s.outer.buffer.capacity() + s.inner.buffer.capacity()) * sizeof(SampleType);
+    }
+    return bytes;
+}
+
+template <typename SampleType>
+void AllpassCascade<SampleType>::clear() {
+    for (auto& s : stages) {
+        std::fill(s.outer.buffer.begin(), s.outer.buffer.end(), SampleType(0));
+        std::fill(s.inner.buffer.begin(), s.inner.buffer.end(), SampleType(0));
+    }
+}
+
+template <typename SampleType>
+SampleType AllpassCascade<SampleType>::tick(Stage& stage, SampleType input) {
+    auto& outer = stage.outer;
+    SampleType delayed = outer.buffer[static_cast<size_t>(outer.index)];
+
+    // Lattice section: the delayed signal runs through the inner allpass first
+    if (stage.nested) {
+        auto& inner = stage.inner;
+        const SampleType innerDelayed = inner.buffer[static_cast<size_t>(inner.index)];
+        inner.buffer[static_cast<size_t>(inner.index)] = delayed + innerDelayed * stage.coeff;
+        if (++inner.index == static_cast<int>(inner.buffer.size())) inner.index = 0;
+        delayed = innerDelayed - delayed;
+    }
+
+    const SampleType output = -input + delayed;
+    outer.buffer[static_cast<size_t>(outer.index)] = input + delayed * stage.coeff;
+    if (++outer.index == static_cast<int>(outer.buffer.size())) outer.index = 0;
+    return output;
+}
+
+template <typename SampleType>
+void AllpassCascade<SampleType>::process(SampleType* buffer, int numSamples) {
+    for (int i = 0; i < numSamples; ++i) {
+        SampleType x = buffer[i];
+        for (int s = 0; s < numStages; ++s) {
+            x = tick(stages[static_cast<size_t>(s)], x);
+        }
+        buffer[i] = x;
+    }
 }
 
-void AllpassFilter::clear() {
-    std::fill(buffer.begin(), buffer.end(), 0.0f);
+template <typename SampleType>
+void AllpassCascade<SampleType>::processPair(AllpassCascade& a, AllpassCascade& b,
+    SampleType* left, SampleType* right, int numSamples) {
+    if (a.numStages != b.numStages) {
+        a.process(left, numSamples);
+        b.process(right, numSamples);
+        return;
+    }
+
+    for (int i = 0; i < numSamples; ++i) {
+        SampleType x = left[i];
+        SampleType y = right[i];
+        for (int s = 0; s < a.numStages; ++s) {
+            x = tick(a.stages[static_cast<size_t>(s)], x);
+            y = tick(b.stages[static_cast<size_t>(s)], y);
+        }
+        left[i] = x;
+        right[i] = y;
+    }
 }
 
 //==============================================================================
 // DelayLine Implementation
 //==============================================================================
 
-DelayLine::DelayLine() : writeIndex(0), readIndex(0), delaySamples(0) {}
+template <typename SampleType>
+DelayLine<SampleType>::DelayLine() : writeIndex(0), readIndex(0), delaySamples(0) {}
 
-void DelayLine::setSize(int samples) {
+template <typename SampleType>
+void DelayLine<SampleType>::setSize(int samples) {
     if (samples <= 0) {
         DBG("ERROR: DelayLine::setSize called with invalid size: " << samples);
         samples = 1;
@@ -195,36 +416,87 @@ void DelayLine::setSize(int samples) {
     readIndex = 0;
 }
 
-void DelayLine::setDelay(int samples) {
+template <typename SampleType>
+void DelayLine<SampleType>::reserve(int samples) {
+    buffer.reserve(static_cast<size_t>(juce::jmax(1, samples)));
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::setDelay(int samples) {
     if (buffer.empty()) return;
     delaySamples = juce::jlimit(0, static_cast<int>(buffer.size()) - 1, samples);
     readIndex = (writeIndex - delaySamples + static_cast<int>(buffer.size())) % static_cast<int>(buffer.size());
 }
 
-float DelayLine::process(float input) {
+template <typename SampleType>
+SampleType DelayLine<SampleType>::process(SampleType input) {
     if (buffer.empty()) return input;
 
     if (writeIndex >= static_cast<int>(buffer.size())) writeIndex = 0;
     if (readIndex >= static_cast<int>(buffer.size())) readIndex = 0;
 
-    float output = buffer[readIndex];
+    SampleType output = buffer[readIndex];
     buffer[writeIndex] = input;
     writeIndex = (writeIndex + 1) % static_cast<int>(buffer.size());
     readIndex = (readIndex + 1) % static_cast<int>(buffer.size());
     return output;
 }
 
-void DelayLine::clear() {
-    std::fill(buffer.begin(), buffer.end(), 0.0f);
+template <typename SampleType>
+SampleType DelayLine<SampleType>::tap(int samplesAgo) const {
+    const int size = static_cast<int>(buffer.size());
+    if (size == 0) return SampleType(0);
+
+    const int index = (writeIndex - 1 - juce::jlimit(0, size - 1, samplesAgo)) % size;
+    return buffer[static_cast<size_t>(index < 0 ? index + size : index)];
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::clear() {
+    std::fill(buffer.begin(), buffer.end(), SampleType(0));
+
+    // Keep the current delay rather than collapsing it to zero
+    const int size = static_cast<int>(buffer.size());
     writeIndex = 0;
-    readIndex = 0;
+    readIndex = size == 0 ? 0 : (size - juce::jlimit(0, size - 1, delaySamples)) % size;
+}
+
+template class OnePole<float>;
+template class OnePole<double>;
+template class DampingFilter<float>;
+template class DampingFilter<double>;
+template class EnhancedCombFilter<float>;
+template class EnhancedCombFilter<double>;
+template class CombFilter<float>;
+template class CombFilter<double>;
+template class AllpassFilter<float>;
+template class AllpassFilter<double>;
+template class AllpassCascade<float>;
+template class AllpassCascade<double>;
+template class DelayLine<float>;
+template class DelayLine<double>;
+
+//==============================================================================
+// ReverbParameters Implementation
+//==============================================================================
+
+const char* ReverbParameters::getID(int index) {
+    static const char* ids[numParameters] = {
+        "decay", "predelay", "damping", "diffusion", "revdiff",
+        "size", "volume", "early", "refdelay", "subdelay",
+        "sublevel", "envelop", "position", "reflect", "tielevel",
+        "mix", "lowdecay", "highdecay", "inputdiff", "duck",
+        "duckatk", "duckrel", "mode", "gatelen", "freeze"
+    };
+    return juce::isPositiveAndBelow(index, static_cast<int>(numParameters)) ? ids[index] : "";
 }
 
 //==============================================================================
 // ReverbProcessor Implementation
 //==============================================================================
 
-ReverbProcessor::ReverbProcessor() {
+template <typename SampleType, typename Topology>
+ReverbProcessor<SampleType, Topology>::ReverbProcessor() {
     // Ensure all parameters match APVTS defaults
     decayTime = 2.0f;
     preDelayMs = 20.0f;
@@ -246,45 +518,128 @@ ReverbProcessor::ReverbProcessor() {
     reverbLevel = 0.0f;
 }
 
-void ReverbProcessor::prepare(double sr) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::prepare(double sr) {
     sampleRate = juce::jlimit(22050.0f, 192000.0f, static_cast<float>(sr));
+    tailSampleRate = sampleRate / Topology::tailDecimation;
 
     // Initialize smoothers
     initSmoothers(sampleRate);
+    updateDuckingCoeffs();
+    freezeSmoother.reset(sampleRate, freezeRampSeconds);
+    resetFadeStep = 1.0f / juce::jmax(1.0f, sampleRate * resetFadeSeconds);
+
+    // Initial filter setup: the topology's combs and allpass stages per channel
+    combsL.fill(CombFilter<SampleType>());
+    combsR.fill(CombFilter<SampleType>());
+    freezeAmount = 0.0f;  // fresh combs; the next block reapplies a held freeze
+    allpassesL.setNumStages(Topology::numAllpasses);
+    allpassesR.setNumStages(Topology::numAllpasses);
+
+    // Input diffuser: fixed short lengths, independent of the room size
+    inputDiffuserL.setNumStages(numInputDiffuserStages);
+    inputDiffuserR.setNumStages(numInputDiffuserStages);
+    for (int i = 0; i < numInputDiffuserStages; ++i) {
+        inputDiffuserL.setSize(i, juce::jmax(1, msToSamples(inputDiffuserDelaysMs[i])));
+        inputDiffuserR.setSize(i, juce::jmax(1, msToSamples(inputDiffuserDelaysMs[i] * 1.02f)));
+        inputDiffuserL.setCoeff(i, inputDiffuserCoeffs[i]);
+        inputDiffuserR.setCoeff(i, inputDiffuserCoeffs[i]);
+    }
 
-    // Initial filter setup
-    combsL.clear();
-    combsR.clear();
-    allpassesL.clear();
-    allpassesR.clear();
+    // Create early reflection taps
+    earlyTaps.fill({ DelayLine<SampleType>(), DelayLine<SampleType>() });
+    preDelayL = preDelayR = DelayLine<SampleType>();
+    prepared = true;
+
+    // Size every buffer for its longest delay up front, then build the current one
+    reserveMaxSizes();
+    lastRoomSize = lastRefDelay = lastSubDelay = -1.0f;
+    lastFeedbackInputs.fill(-1.0f);
+    updateAllParameters();
+    clear();
+
+    DBG("ReverbProcessor prepared. SR: " << sampleRate << "Hz, "
+        << combsL.size() << " combs per channel");
+}
 
-    // Create 8 comb filters for each channel
-    for (int i = 0; i < 8; ++i) {
-        combsL.push_back(CombFilter());
-        combsR.push_back(CombFilter());
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::reserveMaxSizes() {
+    // Combs and allpasses are resized to their exact length as the room
+    // changes, so they reserve their longest one. The delay expressions match
+    // updateAllParameters() so the rounding is identical.
+    for (size_t i = 0; i < combsL.size() && i < baseCombDelaysMs.size(); ++i) {
+        float delayMs = baseCombDelaysMs[i] * maxRoomSize * maxSubsequentDelay;
+        combsL[i].reserve(msToTailSamples(delayMs));
+        combsR[i].reserve(msToTailSamples(delayMs * 1.02f));
     }
 
-    // Create 4 allpass filters for each channel
-    for (int i = 0; i < 4; ++i) {
-        allpassesL.push_back(AllpassFilter());
-        allpassesR.push_back(AllpassFilter());
+    for (int i = 0; i < allpassesL.getNumStages(); ++i) {
+        float delayMs = baseAllpassDelaysMs[static_cast<size_t>(i)] * maxRoomSize;
+        allpassesL.reserve(i, msToTailSamples(delayMs));
+        allpassesR.reserve(i, msToTailSamples(delayMs * 1.02f));
     }
 
-    // Create early reflection taps
-    earlyTaps.clear();
-    for (int i = 0; i < 6; ++i) {
-        earlyTaps.push_back({ DelayLine(), DelayLine() });
+    // Taps and the pre-delay read at a variable delay from a fixed buffer,
+    // one sample longer than the longest delay. Mono taps use only the first line.
+    for (size_t t = 0; t < earlyTaps.size() && t < earlyTapDelaysMs.size(); ++t) {
+        float delayMs = earlyTapDelaysMs[t] * maxRoomSize * maxReflectionDelay;
+        earlyTaps[t].first.setSize(msToSamples(delayMs) + 1);
+        if constexpr (Topology::stereoEarlyTaps) {
+            earlyTaps[t].second.setSize(msToSamples(delayMs * 1.03f) + 1);
+        }
     }
 
-    // Now update all parameters
-    updateAllParameters();
-    clear();
+    preDelayL.setSize(msToSamples(maxPreDelayMs) + 1);
+    preDelayR.setSize(msToSamples(maxPreDelayMs) + 1);
 
-    DBG("ReverbProcessor prepared. SR: " << sampleRate << "Hz, "
-        << combsL.size() << " combs per channel");
+    // Reverse playback reads up to twice the segment length back
+    reverseL.setSize(2 * msToSamples(maxGateLengthMs) + 1);
+    reverseR.setSize(2 * msToSamples(maxGateLengthMs) + 1);
+}
+
+template <typename SampleType, typename Topology>
+size_t ReverbProcessor<SampleType, Topology>::getMemoryBytes() const {
+    size_t samples = 0;
+    for (size_t i = 0; i < combsL.size(); ++i) {
+        samples += combsL[i].buffer.capacity() + combsR[i].buffer.capacity();
+    }
+    for (const auto& tap : earlyTaps) {
+        samples += tap.first.buffer.capacity() + tap.second.buffer.capacity();
+    }
+    samples += preDelayL.buffer.capacity() + preDelayR.buffer.capacity();
+    samples += reverseL.buffer.capacity() + reverseR.buffer.capacity();
+    samples += static_cast<size_t>(parallelBuffer.getNumChannels()) * static_cast<size_t>(parallelBuffer.getNumSamples());
+
+    return sizeof(*this) + samples * sizeof(SampleType)
+        + allpassesL.getMemoryBytes() + allpassesR.getMemoryBytes()
+        + inputDiffuserL.getMemoryBytes() + inputDiffuserR.getMemoryBytes();
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::reserveParallelRendering(int maxBlockSize) {
+    // Larger host blocks are split into chunks of this size
+    parallelBuffer.setSize(numParallelChannels, juce::jmax(maxSubBlockSize, maxBlockSize));
+}
+
+template <typename SampleType, typename Topology>
+std::array<float, 3> ReverbProcessor<SampleType, Topology>::getSmootherState() const {
+    return { decaySmoother.getCurrentValue(), dampingSmoother.getCurrentValue(), mixSmoother.getCurrentValue() };
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::inheritSmootherState(const ReverbVoice<SampleType>& other) {
+    const auto state = other.getSmootherState();
+    decaySmoother.setCurrentAndTargetValue(state[0]);
+    dampingSmoother.setCurrentAndTargetValue(state[1]);
+    mixSmoother.setCurrentAndTargetValue(state[2]);
+
+    decaySmoother.setTargetValue(decayTime);
+    dampingSmoother.setTargetValue(damping);
+    mixSmoother.setTargetValue(dryWet);
 }
 
-void ReverbProcessor::initSmoothers(double sampleRate) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::initSmoothers(double sampleRate) {
     // Set smoothing time constants (50ms)
     float smoothTime = 0.05f;
     decaySmoother.reset(sampleRate, smoothTime);
@@ -296,11 +651,22 @@ void ReverbProcessor::initSmoothers(double sampleRate) {
     mixSmoother.setCurrentAndTargetValue(dryWet);
 }
 
-void ReverbProcessor::clear() {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::clear() {
     for (auto& c : combsL) c.clear();
     for (auto& c : combsR) c.clear();
-    for (auto& a : allpassesL) a.clear();
-    for (auto& a : allpassesR) a.clear();
+    allpassesL.clear();
+    allpassesR.clear();
+    inputDiffuserL.clear();
+    inputDiffuserR.clear();
+    tailDecimator = {};
+    tailInterpolators.fill({});
+    duckEnvelope = 0;
+    gateHoldRemaining = 0;
+    gateGain = 0;
+    reverseL.clear();
+    reverseR.clear();
+    reversePhase = 0;
     preDelayL.clear();
     preDelayR.clear();
     for (auto& tap : earlyTaps) {
@@ -309,99 +675,291 @@ void ReverbProcessor::clear() {
     }
 
     reverbLevel = 0.0f;
+    resetState = ResetState::idle;
+    resetGain = 1.0f;
     DBG("All filters cleared");
 }
 
-void ReverbProcessor::resetWithFade() {
-    // Simple fade-out to avoid clicks
-    static constexpr int fadeSamples = 64;
-    for (int i = 0; i < fadeSamples; ++i) {
-        float fade = 1.0f - static_cast<float>(i) / fadeSamples;
-        for (auto& c : combsL) c.setFeedback(c.feedback * fade);
-        for (auto& c : combsR) c.setFeedback(c.feedback * fade);
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::resetWithFade() {
+    if (!prepared) {
+        clear();
+        return;
     }
-    clear();
-    DBG("Reset with fade applied");
+
+    // A reset requested mid-way starts the clearing over; the fade carries on
+    // from wherever the gain is
+    if (resetState != ResetState::clearing)
+        resetState = ResetState::fadingOut;
+    resetClearStep = 0;
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processResetFade(int numSamples) {
+    if (resetState == ResetState::idle) return;
+
+    SampleType* gain = duckGainBuf.data();
+    if (resetState == ResetState::clearing) {
+        std::fill(gain, gain + numSamples, SampleType(0));
+        return;
+    }
+
+    const float step = resetState == ResetState::fadingOut ? -resetFadeStep : resetFadeStep;
+    for (int i = 0; i < numSamples; ++i) {
+        resetGain = juce::jlimit(0.0f, 1.0f, resetGain + step);
+        gain[i] *= static_cast<SampleType>(resetGain);
+    }
+
+    if (resetState == ResetState::fadingOut && resetGain <= 0.0f)
+        resetState = ResetState::clearing;
+    else if (resetState == ResetState::fadingIn && resetGain >= 1.0f)
+        resetState = ResetState::idle;
 }
 
-void ReverbProcessor::setDecayTime(float seconds) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::advanceReset() {
+    if (resetState != ResetState::clearing) return;
+
+    if (clearStep(resetClearStep++)) {
+        resetState = ResetState::fadingIn;
+        DBG("Reset with fade applied");
+    }
+}
+
+template <typename SampleType, typename Topology>
+bool ReverbProcessor<SampleType, Topology>::clearStep(int step) {
+    // Input reaching a stage after it has been cleared is new signal, so going
+    // from the pre-delay towards the output leaves nothing stale behind
+    static constexpr int firstComb = 3;
+    static constexpr int numCombs = Topology::numCombs;
+
+    if (step == 0) {
+        preDelayL.clear();
+        preDelayR.clear();
+    }
+    else if (step == 1) {
+        for (auto& tap : earlyTaps) {
+            tap.first.clear();
+            tap.second.clear();
+        }
+    }
+    else if (step == 2) {
+        inputDiffuserL.clear();
+        inputDiffuserR.clear();
+        tailDecimator = {};
+        tailInterpolators.fill({});
+    }
+    else if (step < firstComb + numCombs) {
+        combsL[static_cast<size_t>(step - firstComb)].clear();
+        combsR[static_cast<size_t>(step - firstComb)].clear();
+    }
+    else if (step == firstComb + numCombs) {
+        allpassesL.clear();
+        allpassesR.clear();
+    }
+    else if (step == firstComb + numCombs + 1) {
+        reverseL.clear();
+    }
+    else {
+        reverseR.clear();
+        reversePhase = 0;
+        gateHoldRemaining = 0;
+        gateGain = 0;
+        duckEnvelope = 0;
+        reverbLevel = 0.0f;
+        return true;
+    }
+    return false;
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setDecayTime(float seconds) {
     decayTime = juce::jlimit(0.01f, 60.0f, seconds);
     decaySmoother.setTargetValue(decayTime);
     updateFeedback();
 }
 
-void ReverbProcessor::setPreDelay(float ms) {
-    preDelayMs = juce::jlimit(0.0f, 500.0f, ms);
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setPreDelay(float ms) {
+    preDelayMs = juce::jlimit(0.0f, maxPreDelayMs, ms);
     updatePreDelay();
 }
 
-void ReverbProcessor::setDamping(float val) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setDamping(float val) {
     damping = juce::jlimit(0.0f, 0.999f, val);
     dampingSmoother.setTargetValue(damping);
     updateDamping();
 }
 
-void ReverbProcessor::setDiffusion(float val) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setDiffusion(float val) {
     diffusion = juce::jlimit(0.0f, 1.0f, val);
     updateDiffusion();
 }
 
-void ReverbProcessor::setReverbDiffusion(float val) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setReverbDiffusion(float val) {
     reverbDiffusion = juce::jlimit(0.0f, 1.0f, val);
     updateDiffusion();
 }
 
-void ReverbProcessor::setRoomSize(float val) {
-    roomSize = juce::jlimit(0.01f, 2.0f, val);
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setRoomSize(float val) {
+    roomSize = juce::jlimit(0.01f, maxRoomSize, val);
     updateAllParameters();
 }
 
-void ReverbProcessor::setRoomVolume(float val) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setRoomVolume(float val) {
     roomVolume = juce::jlimit(0.0f, 5.0f, val);
 }
 
-void ReverbProcessor::setEarlyReflectionLevel(float val) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setEarlyReflectionLevel(float val) {
     earlyReflectionLevel = juce::jlimit(0.0f, 1.0f, val);
 }
 
-void ReverbProcessor::setReflectionDelay(float val) {
-    reflectionDelay = juce::jlimit(0.1f, 4.0f, val);
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setReflectionDelay(float val) {
+    reflectionDelay = juce::jlimit(0.1f, maxReflectionDelay, val);
     updateReflectionDelays();
 }
 
-void ReverbProcessor::setSubsequentReverbDelay(float val) {
-    subsequentReverbDelay = juce::jlimit(0.1f, 4.0f, val);
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setSubsequentReverbDelay(float val) {
+    subsequentReverbDelay = juce::jlimit(0.1f, maxSubsequentDelay, val);
     updateSubsequentDelays();
 }
 
-void ReverbProcessor::setSubsequentLevel(float val) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setSubsequentLevel(float val) {
     subsequentLevel = juce::jlimit(0.0f, 1.0f, val);
 }
 
-void ReverbProcessor::setEnvelopment(float val) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setEnvelopment(float val) {
     envelopment = juce::jlimit(0.0f, 1.0f, val);
 }
 
-void ReverbProcessor::setNormalizedReflectivity(float val) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setNormalizedReflectivity(float val) {
     normalizedReflectivity = juce::jlimit(0.0f, 1.0f, val);
-    updateFeedback();
 }
 
-void ReverbProcessor::setTieLevel(float val) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setTieLevel(float val) {
     tieLevel = juce::jlimit(0.0f, 1.0f, val);
     updateTieLevel();
 }
 
-void ReverbProcessor::setPosition(float val) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setPosition(float val) {
     position = juce::jlimit(0.0f, 1.0f, val);
 }
 
-void ReverbProcessor::setDryWet(float val) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setDryWet(float val) {
     dryWet = juce::jlimit(0.0f, 1.0f, val);
     mixSmoother.setTargetValue(dryWet);
 }
 
-void ReverbProcessor::processStereo(float* left, float* right, int numSamples) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setLowDecay(float multiplier) {
+    lowDecayMultiplier = juce::jlimit(0.1f, 4.0f, multiplier);
+    updateFeedback();
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setHighDecay(float multiplier) {
+    highDecayMultiplier = juce::jlimit(0.1f, 4.0f, multiplier);
+    updateFeedback();
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setInputDiffusion(float amount) {
+    inputDiffusion = juce::jlimit(0.0f, 1.0f, amount);
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setDucking(float amount, float attackMs, float releaseMs) {
+    duckAmount = juce::jlimit(0.0f, 1.0f, amount);
+    attackMs = juce::jlimit(0.1f, 100.0f, attackMs);
+    releaseMs = juce::jlimit(10.0f, 2000.0f, releaseMs);
+
+    if (attackMs != duckAttackMs || releaseMs != duckReleaseMs) {
+        duckAttackMs = attackMs;
+        duckReleaseMs = releaseMs;
+        updateDuckingCoeffs();
+    }
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setMode(ReverbMode newMode, float lengthMs) {
+    gateLengthMs = juce::jlimit(50.0f, maxGateLengthMs, lengthMs);
+    if (newMode == mode) return;
+
+    // Start reverse playback from silence rather than from stale segments
+    if (newMode == ReverbMode::reverse) {
+        reverseL.clear();
+        reverseR.clear();
+        reversePhase = 0;
+    }
+    mode = newMode;
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setFreeze(bool shouldFreeze) {
+    freezeSmoother.setTargetValue(shouldFreeze ? 1.0f : 0.0f);
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::updateFreeze(int numSamples) {
+    // Stepped once per block; the combs only see a change while ramping
+    const float amount = freezeSmoother.skip(numSamples);
+    if (amount == freezeAmount) return;
+
+    freezeAmount = amount;
+    for (auto& c : combsL) c.setFreeze(amount);
+    for (auto& c : combsR) c.setFreeze(amount);
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::updateDuckingCoeffs() {
+    duckAttackCoeff = static_cast<SampleType>(std::exp(-1000.0f / (duckAttackMs * sampleRate)));
+    duckReleaseCoeff = static_cast<SampleType>(std::exp(-1000.0f / (duckReleaseMs * sampleRate)));
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::setParameters(const ReverbParameters& params) {
+    setDecayTime(params[ReverbParameters::decay]);
+    setPreDelay(params[ReverbParameters::preDelay]);
+    setDamping(params[ReverbParameters::damping]);
+    setDiffusion(params[ReverbParameters::diffusion]);
+    setReverbDiffusion(params[ReverbParameters::reverbDiffusion]);
+    setRoomSize(params[ReverbParameters::size]);
+    setRoomVolume(params[ReverbParameters::volume]);
+    setEarlyReflectionLevel(params[ReverbParameters::early]);
+    setReflectionDelay(params[ReverbParameters::reflectionDelay]);
+    setSubsequentReverbDelay(params[ReverbParameters::subsequentDelay]);
+    setSubsequentLevel(params[ReverbParameters::subsequentLevel]);
+    setEnvelopment(params[ReverbParameters::envelopment]);
+    setPosition(params[ReverbParameters::position]);
+    setNormalizedReflectivity(params[ReverbParameters::reflectivity]);
+    setTieLevel(params[ReverbParameters::tieLevel]);
+    setDryWet(params[ReverbParameters::mix]);
+    setLowDecay(params[ReverbParameters::lowDecay]);
+    setHighDecay(params[ReverbParameters::highDecay]);
+    setInputDiffusion(params[ReverbParameters::inputDiffusion]);
+    setDucking(params[ReverbParameters::duck], params[ReverbParameters::duckAttack],
+        params[ReverbParameters::duckRelease]);
+    setMode(static_cast<ReverbMode>(juce::jlimit(0, 2, juce::roundToInt(params[ReverbParameters::mode]))),
+        params[ReverbParameters::gateLength]);
+    setFreeze(params[ReverbParameters::freeze] >= 0.5f);
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processStereo(SampleType* left, SampleType* right, int numSamples) {
     // Sanity check inputs
     if (left == nullptr || right == nullptr || numSamples <= 0) {
         DBG("ERROR: Invalid inputs to processStereo");
@@ -409,151 +967,558 @@ void ReverbProcessor::processStereo(float* left, float* right, int numSamples) {
     }
 
     // Ensure we have valid state
-    if (combsL.empty() || combsR.empty()) {
+    if (!prepared) {
         DBG("ERROR: Filters not initialized in processStereo!");
         return;
     }
 
+    // A frozen tail circulates indefinitely and a thawing one decays into
+    // denormals, so don't rely on the caller having disabled them
+    juce::ScopedNoDenormals noDenormals;
+    updateFreeze(numSamples);
+
     // Get smoothed parameter values
     float currentDecay = decaySmoother.getNextValue();
     float currentDamping = dampingSmoother.getNextValue();
     float currentMix = mixSmoother.getNextValue();
 
-    for (int i = 0; i < numSamples; ++i) {
-        float dryL = left[i];
-        float dryR = right[i];
+    // With a reserved chunk buffer, offline renders and the opt-in real-time
+    // helper split the late networks across threads
+    if ((renderPool != nullptr || lateNetworkHelper != nullptr) && parallelBuffer.getNumSamples() > 0) {
+        processStereoParallel(left, right, numSamples, currentDecay, currentDamping, currentMix);
+        advanceSidechain(numSamples);
+        advanceReset();
+        return;
+    }
+
+    // Every stage only depends on earlier stages of the same sample, so running
+    // them as separate passes over a sub-block gives the same output as the
+    // per-sample loop while keeping each inner loop tight.
+    for (int offset = 0; offset < numSamples; offset += maxSubBlockSize) {
+        const int n = juce::jmin(maxSubBlockSize, numSamples - offset);
+
+        {
+            DRMK_PROFILE_STAGE(profiler, preDelayStage);
+            processPreDelay(left + offset, right + offset, n);
+        }
+        {
+            DRMK_PROFILE_STAGE(profiler, earlyTapStage);
+            processEarlyTaps(n);
+        }
+        {
+            DRMK_PROFILE_STAGE(profiler, diffuserStage);
+            processInputDiffuser(n);
+        }
+        if constexpr (Topology::tailDecimation > 1) {
+            DRMK_PROFILE_STAGE(profiler, combStage);
+            std::array<SampleType, maxSubBlockSize / Topology::tailDecimation + 1> lowL, lowR, lowOut;
+            decimateTailInput(preBufL.data(), preBufR.data(), lowL.data(), lowR.data(), n);
+            processLateDecimated(0, lowL.data(), lowR.data(), lowOut.data(), lateBufL.data(), n);
+            processLateDecimated(1, lowL.data(), lowR.data(), lowOut.data(), lateBufR.data(), n);
+        }
+        else {
+            {
+                DRMK_PROFILE_STAGE(profiler, combStage);
+                processCombs(0, preBufL.data(), preBufR.data(), lateBufL.data(), n);
+                processCombs(1, preBufL.data(), preBufR.data(), lateBufR.data(), n);
+            }
+            {
+                DRMK_PROFILE_STAGE(profiler, allpassStage);
+                AllpassCascade<SampleType>::processPair(allpassesL, allpassesR, lateBufL.data(), lateBufR.data(), n);
+            }
+        }
+        {
+            DRMK_PROFILE_STAGE(profiler, outputStage);
+            processOutput(left + offset, right + offset, n, offset, currentDecay, currentDamping, currentMix);
+        }
+    }
 
-        // Apply input gain/volume with soft limiting
-        float gain = roomVolume;
-        dryL *= juce::jlimit(0.0f, 2.0f, gain);
-        dryR *= juce::jlimit(0.0f, 2.0f, gain);
+    advanceSidechain(numSamples);
+    advanceReset();
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processPreDelay(const SampleType* left, const SampleType* right, int numSamples) {
+    // Apply input gain/volume with soft limiting
+    const SampleType gain = juce::jlimit(0.0f, 2.0f, roomVolume);
+
+    for (int i = 0; i < numSamples; ++i) {
+        dryBufL[i] = left[i] * gain;
+        dryBufR[i] = right[i] * gain;
 
         // Pre-delay (preserves stereo)
-        float preL = preDelayL.process(dryL);
-        float preR = preDelayR.process(dryR);
+        preBufL[i] = preDelayL.process(dryBufL[i]);
+        preBufR[i] = preDelayR.process(dryBufR[i]);
+    }
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processEarlyTaps(int numSamples) {
+    constexpr int numTaps = Topology::numTaps;
+
+    // Eco: one set of lines on the mono sum, centred in both channels
+    if constexpr (!Topology::stereoEarlyTaps) {
+        const SampleType level = earlyReflectionLevel;
+        const SampleType norm = static_cast<SampleType>(numTaps);
+        for (int i = 0; i < numSamples; ++i) {
+            const SampleType mono = (preBufL[i] + preBufR[i]) * SampleType(0.5f);
+            SampleType sum = 0;
+            for (int t = 0; t < numTaps; ++t) {
+                sum += earlyTaps[t].first.process(mono);
+            }
+            earlyBufL[i] = earlyBufR[i] = sum * SampleType(0.65f) * level / norm;
+        }
+        return;
+    }
+
+    // Progressive panning across taps for natural stereo
+    std::array<SampleType, numTaps> gainL, gainR;
+    for (int t = 0; t < numTaps; ++t) {
+        float pan = static_cast<float>(t) / numTaps;
+        gainL[t] = 1.0f - pan * 0.7f;
+        gainR[t] = 0.3f + pan * 0.7f;
+    }
+
+    // Early reflections - maintain stereo image. The tap count is a constant,
+    // so the inner loop unrolls and the sums stay in registers.
+    for (int i = 0; i < numSamples; ++i) {
+        SampleType sumL = 0, sumR = 0;
+        for (int t = 0; t < numTaps; ++t) {
+            sumL += earlyTaps[t].first.process(preBufL[i]) * gainL[t];
+            sumR += earlyTaps[t].second.process(preBufR[i]) * gainR[t];
+        }
+        earlyBufL[i] = sumL;
+        earlyBufR[i] = sumR;
+    }
+
+    const SampleType level = earlyReflectionLevel;
+    const SampleType norm = static_cast<SampleType>(numTaps);
+    for (int i = 0; i < numSamples; ++i) {
+        earlyBufL[i] = earlyBufL[i] * level / norm;
+        earlyBufR[i] = earlyBufR[i] * level / norm;
+    }
+}
 
-        // Early reflections - maintain stereo image
-        float earlyL = 0.0f, earlyR = 0.0f;
-        for (size_t t = 0; t < earlyTaps.size(); ++t) {
-            // Progressive panning across taps for natural stereo
-            float pan = static_cast<float>(t) / earlyTaps.size();
-            earlyL += earlyTaps[t].first.process(preL) * (1.0f - pan * 0.7f);
-            earlyR += earlyTaps[t].second.process(preR) * (0.3f + pan * 0.7f);
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processInputDiffuser(int numSamples) {
+    const float start = lastInputDiffusion, end = inputDiffusion;
+    lastInputDiffusion = inputDiffusion;
+
+    // Bypassed entirely at 0, so the default sound and cost are unchanged
+    if (start <= 0.0f && end <= 0.0f) return;
+
+    // Coming back from 0, drop what the cascades held when they were last used
+    if (start <= 0.0f) {
+        inputDiffuserL.clear();
+        inputDiffuserR.clear();
+    }
+
+    // Diffuse copies of the comb input (the early taps have already read the
+    // clean pre-delayed signal), then crossfade them in along the sub-block
+    std::array<SampleType, maxSubBlockSize> diffusedL, diffusedR;
+    std::copy(preBufL.begin(), preBufL.begin() + numSamples, diffusedL.begin());
+    std::copy(preBufR.begin(), preBufR.begin() + numSamples, diffusedR.begin());
+    AllpassCascade<SampleType>::processPair(inputDiffuserL, inputDiffuserR, diffusedL.data(), diffusedR.data(), numSamples);
+
+    const float step = (end - start) / static_cast<float>(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        const SampleType amount = start + step * static_cast<float>(i + 1);
+        preBufL[i] += (diffusedL[i] - preBufL[i]) * amount;
+        preBufR[i] += (diffusedR[i] - preBufR[i]) * amount;
+    }
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processCombs(int channel, const SampleType* inL, const SampleType* inR,
+    SampleType* out, int numSamples) {
+    constexpr int numCombs = Topology::numCombs;
+
+    auto& combs = channel == 0 ? combsL : combsR;
+    const SampleType* inSame = channel == 0 ? inL : inR;
+    const SampleType* inOther = channel == 0 ? inR : inL;
+    const SampleType pos = channel == 0 ? position : 1.0f - position;
+
+    // Each comb gets a unique mix of L/R for natural stereo spread, with a
+    // cross-feed from the other channel and slight detuning for a richer sound.
+    // Freezing mutes the input through the detune gain, at no per-sample cost.
+    const float inputGain = 1.0f - freezeAmount;
+    std::array<SampleType, numCombs> sameWeight, otherWeight, detune;
+    for (int c = 0; c < numCombs; ++c) {
+        const float angle = static_cast<float>(c) * 0.5f;
+        sameWeight[c] = channel == 0 ? 0.7f + 0.3f * std::sin(angle) : 0.7f + 0.3f * std::cos(angle);
+        otherWeight[c] = channel == 0 ? 0.3f * std::cos(angle) : 0.3f * std::sin(angle);
+        detune[c] = (channel == 0 ? 1.0f + (0.0005f * c) : 1.0f - (0.0005f * c)) * inputGain;
+    }
+
+    // The comb count is a constant, so the inner loop unrolls and the sum
+    // stays in a register; lines are still summed in the same order
+    for (int i = 0; i < numSamples; ++i) {
+        SampleType sum = 0;
+        for (int c = 0; c < numCombs; ++c) {
+            SampleType combInput = (inSame[i] * sameWeight[c] + inOther[i] * otherWeight[c] * pos);
+            sum += combs[c].process(combInput * detune[c]);
+        }
+        out[i] = sum;
+    }
+
+    const SampleType norm = static_cast<SampleType>(numCombs);
+    for (int i = 0; i < numSamples; ++i) {
+        out[i] /= norm;
+    }
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processAllpasses(int channel, SampleType* buffer, int numSamples) {
+    // Apply allpass diffusion (series) for smoother tail
+    (channel == 0 ? allpassesL : allpassesR).process(buffer, numSamples);
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processLateNetwork(int channel, int numSamples) {
+    SampleType* out = parallelBuffer.getWritePointer(channel == 0 ? lateL : lateR);
+
+    // The tail-rate input was decimated for both channels before the split
+    if constexpr (Topology::tailDecimation > 1) {
+        processLateDecimated(channel, parallelBuffer.getReadPointer(tailInL), parallelBuffer.getReadPointer(tailInR),
+            parallelBuffer.getWritePointer(channel == 0 ? tailOutL : tailOutR), out, numSamples);
+    }
+    else {
+        processCombs(channel, parallelBuffer.getReadPointer(preL), parallelBuffer.getReadPointer(preR), out, numSamples);
+        processAllpasses(channel, out, numSamples);
+    }
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::decimateTailInput(const SampleType* inL, const SampleType* inR,
+    SampleType* lowL, SampleType* lowR, int numSamples) {
+    constexpr int factor = Topology::tailDecimation;
+    auto& d = tailDecimator;
+    d.startPhase = d.phase;
+
+    // Average each group of input samples down to the tail rate
+    int numLow = 0;
+    for (int i = 0; i < numSamples; ++i) {
+        d.sumL += inL[i];
+        d.sumR += inR[i];
+        if (++d.phase == factor) {
+            lowL[numLow] = d.sumL / SampleType(factor);
+            lowR[numLow] = d.sumR / SampleType(factor);
+            ++numLow;
+            d.sumL = d.sumR = 0;
+            d.phase = 0;
         }
-        earlyL = earlyL * earlyReflectionLevel / static_cast<float>(earlyTaps.size());
-        earlyR = earlyR * earlyReflectionLevel / static_cast<float>(earlyTaps.size());
+    }
+    d.numLow = numLow;
+}
 
-        // Process left channel through left combs with cross-feed from right
-        float combSumL = 0.0f;
-        for (size_t c = 0; c < combsL.size(); ++c) {
-            // Each comb gets a unique mix of L/R for natural stereo spread
-            float leftWeight = 0.7f + 0.3f * std::sin(static_cast<float>(c) * 0.5f);
-            float rightWeight = 0.3f * std::cos(static_cast<float>(c) * 0.5f);
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processLateDecimated(int channel, const SampleType* lowL,
+    const SampleType* lowR, SampleType* lowOut, SampleType* out, int numSamples) {
+    constexpr int factor = Topology::tailDecimation;
+    auto& interp = tailInterpolators[static_cast<size_t>(channel)];
 
-            float combInput = (preL * leftWeight + preR * rightWeight * position);
+    // Run the tail at the reduced rate on the samples decimateTailInput() produced
+    processCombs(channel, lowL, lowR, lowOut, tailDecimator.numLow);
+    processAllpasses(channel, lowOut, tailDecimator.numLow);
 
-            // Add slight detuning between combs for richer sound
-            float detune = 1.0f + (0.0005f * c);
-            combSumL += combsL[c].process(combInput * detune);
+    // Interpolate back up to the full rate, one tail-rate sample behind
+    int phase = tailDecimator.startPhase, k = 0;
+    for (int i = 0; i < numSamples; ++i) {
+        if (++phase == factor) {
+            phase = 0;
+            interp.previous = interp.next;
+            interp.next = lowOut[k++];
         }
-        combSumL /= static_cast<float>(combsL.size());
+        out[i] = interp.previous + (interp.next - interp.previous) * SampleType(phase + 1) / SampleType(factor);
+    }
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::runRightLateNetwork(void* context, int numSamples) {
+    juce::ScopedNoDenormals noDenormals;
+    static_cast<ReverbProcessor*>(context)->processLateNetwork(1, numSamples);
+}
 
-        // Process right channel through right combs with cross-feed from left
-        float combSumR = 0.0f;
-        for (size_t c = 0; c < combsR.size(); ++c) {
-            float rightWeight = 0.7f + 0.3f * std::cos(static_cast<float>(c) * 0.5f);
-            float leftWeight = 0.3f * std::sin(static_cast<float>(c) * 0.5f);
+template <typename SampleType, typename Topology>
+juce::ThreadPoolJob::JobStatus ReverbProcessor<SampleType, Topology>::LateNetworkJob::runJob() {
+    juce::ScopedNoDenormals noDenormals;
+    owner.processLateNetwork(1, numSamples);
+    finished.store(true, std::memory_order_release);
+    return jobHasFinished;
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processStereoParallel(SampleType* left, SampleType* right, int numSamples,
+    float& currentDecay, float& currentDamping, float& currentMix) {
+    const int chunkSize = parallelBuffer.getNumSamples();
+
+    for (int chunk = 0; chunk < numSamples; chunk += chunkSize) {
+        const int chunkLength = juce::jmin(chunkSize, numSamples - chunk);
+
+        // Input stages for the whole chunk, keeping what the output pass needs
+        for (int offset = 0; offset < chunkLength; offset += maxSubBlockSize) {
+            const int n = juce::jmin(maxSubBlockSize, chunkLength - offset);
+            {
+                DRMK_PROFILE_STAGE(profiler, preDelayStage);
+                processPreDelay(left + chunk + offset, right + chunk + offset, n);
+            }
+            {
+                DRMK_PROFILE_STAGE(profiler, earlyTapStage);
+                processEarlyTaps(n);
+            }
+            {
+                DRMK_PROFILE_STAGE(profiler, diffuserStage);
+                processInputDiffuser(n);
+            }
+
+            std::copy(dryBufL.begin(), dryBufL.begin() + n, parallelBuffer.getWritePointer(dryL, offset));
+            std::copy(dryBufR.begin(), dryBufR.begin() + n, parallelBuffer.getWritePointer(dryR, offset));
+            std::copy(preBufL.begin(), preBufL.begin() + n, parallelBuffer.getWritePointer(preL, offset));
+            std::copy(preBufR.begin(), preBufR.begin() + n, parallelBuffer.getWritePointer(preR, offset));
+            std::copy(earlyBufL.begin(), earlyBufL.begin() + n, parallelBuffer.getWritePointer(earlyL, offset));
+            std::copy(earlyBufR.begin(), earlyBufR.begin() + n, parallelBuffer.getWritePointer(earlyR, offset));
+        }
 
-            float combInput = (preR * rightWeight + preL * leftWeight * (1.0f - position));
+        if constexpr (Topology::tailDecimation > 1) {
+            decimateTailInput(parallelBuffer.getReadPointer(preL), parallelBuffer.getReadPointer(preR),
+                parallelBuffer.getWritePointer(tailInL), parallelBuffer.getWritePointer(tailInR), chunkLength);
+        }
 
-            float detune = 1.0f - (0.0005f * c);
-            combSumR += combsR[c].process(combInput * detune);
+        // The left and right late networks only share their (read-only) input,
+        // so the right one goes to another thread while this one runs the left
+        if (lateNetworkHelper != nullptr) {
+            DRMK_PROFILE_STAGE(profiler, combStage);
+            lateNetworkHelper->dispatch(&ReverbProcessor::runRightLateNetwork, this, chunkLength);
+            processLateNetwork(0, chunkLength);
+            lateNetworkHelper->join();
+        }
+        else {
+            DRMK_PROFILE_STAGE(profiler, combStage);
+            lateNetworkJob.numSamples = chunkLength;
+            lateNetworkJob.finished.store(false, std::memory_order_relaxed);
+            renderPool->addJob(&lateNetworkJob, false);
+
+            processLateNetwork(0, chunkLength);
+
+            // Take the job back if no worker has picked it up yet, otherwise wait for it
+            renderPool->removeJob(&lateNetworkJob, false, -1);
+            if (!lateNetworkJob.finished.load(std::memory_order_acquire)) {
+                processLateNetwork(1, chunkLength);
+            }
         }
-        combSumR /= static_cast<float>(combsR.size());
 
-        // Apply allpass diffusion (series) for smoother tail
-        float diffusedL = combSumL;
-        float diffusedR = combSumR;
-        for (size_t a = 0; a < allpassesL.size(); ++a) {
-            diffusedL = allpassesL[a].process(diffusedL);
-            diffusedR = allpassesR[a].process(diffusedR);
+        for (int offset = 0; offset < chunkLength; offset += maxSubBlockSize) {
+            const int n = juce::jmin(maxSubBlockSize, chunkLength - offset);
+
+            std::copy_n(parallelBuffer.getReadPointer(dryL, offset), n, dryBufL.begin());
+            std::copy_n(parallelBuffer.getReadPointer(dryR, offset), n, dryBufR.begin());
+            std::copy_n(parallelBuffer.getReadPointer(earlyL, offset), n, earlyBufL.begin());
+            std::copy_n(parallelBuffer.getReadPointer(earlyR, offset), n, earlyBufR.begin());
+            std::copy_n(parallelBuffer.getReadPointer(lateL, offset), n, lateBufL.begin());
+            std::copy_n(parallelBuffer.getReadPointer(lateR, offset), n, lateBufR.begin());
+
+            DRMK_PROFILE_STAGE(profiler, outputStage);
+            processOutput(left + chunk + offset, right + chunk + offset, n, chunk + offset,
+                currentDecay, currentDamping, currentMix);
         }
+    }
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processOutput(SampleType* left, SampleType* right, int numSamples, int blockOffset,
+    float& currentDecay, float& currentDamping, float& currentMix) {
+    // Apply subsequent/tail level with HF emphasis
+    const SampleType tailLevel = subsequentLevel * tieLevelGain;
+
+    // Combine early reflections + late reverb with energy conservation
+    const SampleType earlyMix = 0.3f;
+    const SampleType lateMix = 0.7f;
+
+    // Apply frequency contour (tieLevel affects high frequencies)
+    const SampleType hfGain = 1.0f + tieLevel * 2.0f * 0.5f;
+
+    const SampleType width = envelopment;
+    const SampleType reflectivity = normalizedReflectivity;
 
-        // Apply subsequent/tail level with HF emphasis
-        float tailLevel = subsequentLevel * tieLevelGain;
-        diffusedL *= tailLevel;
-        diffusedR *= tailLevel;
+    processMode(numSamples);
+    processDucking(numSamples, blockOffset);
+    processResetFade(numSamples);
+
+    for (int i = 0; i < numSamples; ++i) {
+        SampleType diffusedL = lateBufL[i] * tailLevel;
+        SampleType diffusedR = lateBufR[i] * tailLevel;
 
         // M/S processing with envelopment control for width
-        float mid = (diffusedL + diffusedR) * 0.707f;
-        float side = (diffusedL - diffusedR) * 0.707f;
+        SampleType mid = (diffusedL + diffusedR) * SampleType(0.707f);
+        SampleType side = (diffusedL - diffusedR) * SampleType(0.707f);
 
-        float wetL = mid + side * envelopment;
-        float wetR = mid - side * envelopment;
+        SampleType wetL = mid + side * width;
+        SampleType wetR = mid - side * width;
 
-        // Combine early reflections + late reverb with energy conservation
-        float earlyMix = 0.3f;
-        float lateMix = 0.7f;
-        wetL = (earlyL * earlyMix + wetL * lateMix) * normalizedReflectivity;
-        wetR = (earlyR * earlyMix + wetR * lateMix) * normalizedReflectivity;
+        wetL = (earlyBufL[i] * earlyMix + wetL * lateMix) * reflectivity;
+        wetR = (earlyBufR[i] * earlyMix + wetR * lateMix) * reflectivity;
 
-        // Apply frequency contour (tieLevel affects high frequencies)
-        float hfBoost = tieLevel * 2.0f;
-        wetL = wetL * (1.0f + hfBoost * 0.5f);
-        wetR = wetR * (1.0f + hfBoost * 0.5f);
+        wetL = wetL * hfGain * duckGainBuf[i];
+        wetR = wetR * hfGain * duckGainBuf[i];
 
         // Final dry/wet mix with smooth transition
-        float smoothMix = currentMix;
-        if (i == 0) {
+        const int sampleIndex = blockOffset + i;
+        SampleType smoothMix = currentMix;
+        if (sampleIndex == 0) {
             smoothMix = mixSmoother.getCurrentValue();
         }
 
-        left[i] = dryL * (1.0f - smoothMix) + wetL * smoothMix;
-        right[i] = dryR * (1.0f - smoothMix) + wetR * smoothMix;
+        left[i] = dryBufL[i] * (SampleType(1) - smoothMix) + wetL * smoothMix;
+        right[i] = dryBufR[i] * (SampleType(1) - smoothMix) + wetR * smoothMix;
+        wetMonoBuf[i] = static_cast<float>((wetL + wetR) * SampleType(0.5f));
 
         // Update reverb level for visualization
-        reverbLevel = 0.995f * reverbLevel + 0.005f * std::sqrt(wetL * wetL + wetR * wetR);
+        reverbLevel = 0.995f * reverbLevel + 0.005f * static_cast<float>(std::sqrt(wetL * wetL + wetR * wetR));
 
         // Protect against clipping with soft limiting
-        left[i] = juce::jlimit(-1.0f, 1.0f, left[i] * 0.95f);
-        right[i] = juce::jlimit(-1.0f, 1.0f, right[i] * 0.95f);
+        left[i] = juce::jlimit(SampleType(-1), SampleType(1), left[i] * SampleType(0.95f));
+        right[i] = juce::jlimit(SampleType(-1), SampleType(1), right[i] * SampleType(0.95f));
 
         // Update smoothers
-        if (i % 8 == 0) {  // Update less frequently for performance
+        if (sampleIndex % 8 == 0) {  // Update less frequently for performance
             currentDecay = decaySmoother.getNextValue();
             currentDamping = dampingSmoother.getNextValue();
             currentMix = mixSmoother.getNextValue();
         }
     }
+
+    if (tailAnalyser != nullptr) {
+        tailAnalyser->push(wetMonoBuf.data(), numSamples);
+    }
 }
 
-int ReverbProcessor::msToSamples(float ms) {
-    if (ms < 0.0f) ms = 0.0f;
-    if (sampleRate <= 0.0f) {
-        DBG("ERROR: Invalid sample rate in msToSamples: " << sampleRate);
-        sampleRate = 44100.0f;
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processMode(int numSamples) {
+    switch (mode) {
+        case ReverbMode::gated: processGate(numSamples); break;
+        case ReverbMode::reverse: processReverse(numSamples); break;
+        case ReverbMode::normal:
+        default: break;
     }
-    return static_cast<int>(sampleRate * ms / 1000.0f);
 }
 
-void ReverbProcessor::updateAllParameters() {
-    if (sampleRate <= 0.0f) {
-        DBG("ERROR: updateAllParameters called before sample rate was set!");
-        return;
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processGate(int numSamples) {
+    // One open/closed decision per sub-block from the dry input's peak
+    const auto rangeL = juce::FloatVectorOperations::findMinAndMax(dryBufL.data(), numSamples);
+    const auto rangeR = juce::FloatVectorOperations::findMinAndMax(dryBufR.data(), numSamples);
+    const SampleType peak = juce::jmax(-rangeL.getStart(), rangeL.getEnd(), -rangeR.getStart(), rangeR.getEnd());
+
+    if (peak > static_cast<SampleType>(gateThreshold)) {
+        gateHoldRemaining = msToSamples(gateLengthMs);
+    }
+    else {
+        gateHoldRemaining = juce::jmax(0, gateHoldRemaining - numSamples);
     }
 
-    // Track changes to avoid unnecessary updates
-    static float lastRoomSize = roomSize;
-    static float lastRefDelay = reflectionDelay;
-    static float lastSubDelay = subsequentReverbDelay;
+    // Opens within the sub-block, closes over gateReleaseMs
+    SampleType target = gateHoldRemaining > 0 ? SampleType(1) : SampleType(0);
+    if (target < gateGain) {
+        const SampleType maxStep = static_cast<SampleType>(numSamples) / juce::jmax(1, msToSamples(gateReleaseMs));
+        target = juce::jmax(target, gateGain - maxStep);
+    }
 
+    const SampleType step = (target - gateGain) / numSamples;
+    SampleType gain = gateGain;
+    for (int i = 0; i < numSamples; ++i) {
+        gain += step;
+        lateBufL[i] *= gain;
+        lateBufR[i] *= gain;
+    }
+    gateGain = target;
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processReverse(int numSamples) {
+    // Two grains half a segment apart each read the ring backwards; their
+    // triangular windows overlap-add to one, so segment joins are crossfaded
+    const int length = juce::jmax(2, msToSamples(gateLengthMs));
+    const int half = length / 2;
+    const SampleType scale = SampleType(2) / length;
+
+    for (int i = 0; i < numSamples; ++i) {
+        reverseL.process(lateBufL[i]);
+        reverseR.process(lateBufR[i]);
+
+        if (reversePhase >= length) reversePhase = 0;
+
+        SampleType outL = 0, outR = 0;
+        for (int phase : { reversePhase, (reversePhase + half) % length }) {
+            const SampleType window = SampleType(1) - std::abs(phase * scale - SampleType(1));
+            outL += reverseL.tap(2 * phase) * window;
+            outR += reverseR.tap(2 * phase) * window;
+        }
+
+        lateBufL[i] = outL;
+        lateBufR[i] = outR;
+        ++reversePhase;
+    }
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::processDucking(int numSamples, int blockOffset) {
+    SampleType* gain = duckGainBuf.data();
+
+    if (duckAmount <= 0.0f) {
+        std::fill(gain, gain + numSamples, SampleType(1));
+        duckEnvelope = 0;
+        return;
+    }
+
+    // Key level: the louder channel of the sidechain, or of the dry input
+    const SampleType* keyL = sidechainL != nullptr ? sidechainL + blockOffset : dryBufL.data();
+    const SampleType* keyR = sidechainL != nullptr ? sidechainR + blockOffset : dryBufR.data();
+    std::array<SampleType, maxSubBlockSize> keyAbsR;
+    juce::FloatVectorOperations::abs(gain, keyL, numSamples);
+    juce::FloatVectorOperations::abs(keyAbsR.data(), keyR, numSamples);
+    juce::FloatVectorOperations::max(gain, gain, keyAbsR.data(), numSamples);
+
+    // Attack/release peak follower; the only per-sample recursion
+    SampleType env = duckEnvelope;
+    const SampleType attack = duckAttackCoeff, release = duckReleaseCoeff;
+    for (int i = 0; i < numSamples; ++i) {
+        const SampleType x = gain[i];
+        env = x + (x > env ? attack : release) * (env - x);
+        gain[i] = env;
+    }
+    duckEnvelope = env;
+
+    // gain = 1 - amount * min(1, env * fullScale)
+    juce::FloatVectorOperations::multiply(gain, static_cast<SampleType>(duckFullScale), numSamples);
+    juce::FloatVectorOperations::min(gain, gain, SampleType(1), numSamples);
+    juce::FloatVectorOperations::multiply(gain, static_cast<SampleType>(-duckAmount), numSamples);
+    juce::FloatVectorOperations::add(gain, SampleType(1), numSamples);
+}
+
+template <typename SampleType, typename Topology>
+int ReverbProcessor<SampleType, Topology>::msToSamples(float ms) {
+    if (ms < 0.0f) ms = 0.0f;
+    if (sampleRate <= 0.0f) {
+        DBG("ERROR: Invalid sample rate in msToSamples: " << sampleRate);
+        sampleRate = 44100.0f;
+    }
+    return static_cast<int>(sampleRate * ms / 1000.0f);
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::updateAllParameters() {
+    if (sampleRate <= 0.0f) {
+        DBG("ERROR: updateAllParameters called before sample rate was set!");
+        return;
+    }
+
+    // Track changes to avoid unnecessary updates
     bool sizeChanged = std::abs(roomSize - lastRoomSize) > 0.001f;
     bool refChanged = std::abs(reflectionDelay - lastRefDelay) > 0.001f;
     bool subChanged = std::abs(subsequentReverbDelay - lastSubDelay) > 0.001f;
 
     // Only update if parameters changed significantly
-    if (!sizeChanged && !refChanged && !subChanged &&
-        !combsL.empty() && !combsR.empty()) {
+    if (!sizeChanged && !refChanged && !subChanged && prepared) {
         // Update other parameters without recreating filters
         updateFeedback();
         updateDamping();
@@ -563,12 +1528,12 @@ void ReverbProcessor::updateAllParameters() {
         return;
     }
 
-    float sizeScalar = juce::jlimit(0.01f, 2.0f, roomSize);
+    float sizeScalar = juce::jlimit(0.01f, maxRoomSize, roomSize);
 
     // Update comb filters
     for (size_t i = 0; i < combsL.size() && i < baseCombDelaysMs.size(); ++i) {
         float delayMs = baseCombDelaysMs[i] * sizeScalar * subsequentReverbDelay;
-        int delaySamples = msToSamples(delayMs);
+        int delaySamples = msToTailSamples(delayMs);
 
         if (delaySamples < 1) delaySamples = 1;
 
@@ -576,23 +1541,23 @@ void ReverbProcessor::updateAllParameters() {
         if (static_cast<int>(combsL[i].buffer.size()) != delaySamples) {
             combsL[i].setSize(delaySamples);
         }
-        if (static_cast<int>(combsR[i].buffer.size()) != msToSamples(delayMs * 1.02f)) {
-            combsR[i].setSize(msToSamples(delayMs * 1.02f));
+        if (static_cast<int>(combsR[i].buffer.size()) != msToTailSamples(delayMs * 1.02f)) {
+            combsR[i].setSize(msToTailSamples(delayMs * 1.02f));
         }
     }
 
     // Update allpass filters
-    for (size_t i = 0; i < allpassesL.size() && i < baseAllpassDelaysMs.size(); ++i) {
-        float delayMs = baseAllpassDelaysMs[i] * sizeScalar;
-        int delaySamples = msToSamples(delayMs);
+    for (int i = 0; i < allpassesL.getNumStages(); ++i) {
+        float delayMs = baseAllpassDelaysMs[static_cast<size_t>(i)] * sizeScalar;
+        int delaySamples = msToTailSamples(delayMs);
 
         if (delaySamples < 1) delaySamples = 1;
 
-        if (static_cast<int>(allpassesL[i].buffer.size()) != delaySamples) {
-            allpassesL[i].setSize(delaySamples);
+        if (allpassesL.getSize(i) != delaySamples) {
+            allpassesL.setSize(i, delaySamples);
         }
-        if (static_cast<int>(allpassesR[i].buffer.size()) != msToSamples(delayMs * 1.02f)) {
-            allpassesR[i].setSize(msToSamples(delayMs * 1.02f));
+        if (allpassesR.getSize(i) != msToTailSamples(delayMs * 1.02f)) {
+            allpassesR.setSize(i, msToTailSamples(delayMs * 1.02f));
         }
     }
 
@@ -600,19 +1565,9 @@ void ReverbProcessor::updateAllParameters() {
     for (size_t t = 0; t < earlyTaps.size() && t < earlyTapDelaysMs.size(); ++t) {
         float delayMs = earlyTapDelaysMs[t] * sizeScalar * reflectionDelay;
 
-        int delaySamplesL = msToSamples(delayMs);
-        int delaySamplesR = msToSamples(delayMs * 1.03f);
-
-        // Set size if needed, then delay
-        if (static_cast<int>(earlyTaps[t].first.buffer.size()) < delaySamplesL) {
-            earlyTaps[t].first.setSize(delaySamplesL * 2);  // Extra headroom
-        }
-        earlyTaps[t].first.setDelay(delaySamplesL);
-
-        if (static_cast<int>(earlyTaps[t].second.buffer.size()) < delaySamplesR) {
-            earlyTaps[t].second.setSize(delaySamplesR * 2);
-        }
-        earlyTaps[t].second.setDelay(delaySamplesR);
+        // Buffers were sized for the longest delay in reserveMaxSizes()
+        earlyTaps[t].first.setDelay(msToSamples(delayMs));
+        earlyTaps[t].second.setDelay(msToSamples(delayMs * 1.03f));
     }
 
     // Update all other parameters
@@ -631,75 +1586,102 @@ void ReverbProcessor::updateAllParameters() {
         << ", Comb count: " << combsL.size());
 }
 
-void ReverbProcessor::updateFeedback() {
-    if (combsL.empty() || combsR.empty() || decayTime <= 0.0f || sampleRate <= 0.0f) {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::updateFeedback() {
+    if (!prepared || decayTime <= 0.0f || sampleRate <= 0.0f) {
         DBG("ERROR: updateFeedback called with invalid state");
         return;
     }
 
-    // Calculate feedback for RT60 decay time
-    float avgCombDelayMs = baseCombDelaysMs[0] * roomSize * subsequentReverbDelay;
-    float avgCombDelaySec = avgCombDelayMs / 1000.0f;
-
     if (decayTime < 0.01f) decayTime = 0.01f;
 
-    // Formula: g = 10^(-3 * delay / decayTime)
-    float exponent = -3.0f * avgCombDelaySec / decayTime;
-    float baseFeedback = std::pow(10.0f, exponent);
+    // setParameters() runs every block; only recompute when an input changed
+    const std::array<float, 5> inputs = { decayTime, lowDecayMultiplier,
+        highDecayMultiplier, sampleRate, roomSize * subsequentReverbDelay };
+    if (inputs == lastFeedbackInputs) return;
+    lastFeedbackInputs = inputs;
+
+    // Each line gets the gain that decays it by 60dB in decayTime from its own
+    // length d: g = 10^(-3d / (fs * T60)) = exp(k * d). Reflectivity scales
+    // the wet output instead, so it never shortens the decay.
+    constexpr int numCombs = Topology::numCombs;
+    std::array<float, numCombs * 2> gains{};
+
+    for (int i = 0; i < numCombs; ++i) gains[i] = static_cast<float>(combsL[i].buffer.size());
+    for (int i = 0; i < numCombs; ++i) gains[numCombs + i] = static_cast<float>(combsR[i].buffer.size());
+
+    // One batched pass over every line
+    const float k = -3.0f * std::log(10.0f) / (tailSampleRate * decayTime);
+    for (auto& g : gains) {
+        g = juce::jlimit(0.0f, 0.998f, std::exp(k * g));
+    }
 
-    // Apply reflectivity
-    baseFeedback *= normalizedReflectivity;
+    for (int i = 0; i < numCombs; ++i) combsL[i].setFeedback(gains[i]);
+    for (int i = 0; i < numCombs; ++i) combsR[i].setFeedback(gains[numCombs + i]);
 
-    // Safety limit with margin
-    baseFeedback = juce::jlimit(0.0f, 0.998f, baseFeedback);
+    updateDecayShelves();
 
-    // Apply with slight variations between combs for richer sound
-    for (size_t i = 0; i < combsL.size(); ++i) {
-        float variation = 1.0f + (0.015f * (i % 4));
-        combsL[i].setFeedback(baseFeedback * variation);
-        combsR[i].setFeedback(baseFeedback * (1.0f / variation));
-    }
+    DBG("Feedback updated for decayTime: " << decayTime << " (first line: " << gains[0] << ")");
+}
+
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::updateDecayShelves() {
+    const float lowCoeff = std::exp(-juce::MathConstants<float>::twoPi * lowCrossoverHz / tailSampleRate);
+    const float highCoeff = std::exp(-juce::MathConstants<float>::twoPi * highCrossoverHz / tailSampleRate);
+
+    // The broadband feedback already sets the mid band, so each shelf applies the
+    // ratio between its band's target loop gain and the mid gain, again from the
+    // line's own length
+    const float lowRate = 1.0f / (decayTime * lowDecayMultiplier) - 1.0f / decayTime;
+    const float highRate = 1.0f / (decayTime * highDecayMultiplier) - 1.0f / decayTime;
+
+    auto applyTo = [&](CombFilter<SampleType>& comb) {
+        const float delaySeconds = static_cast<float>(comb.buffer.size()) / tailSampleRate;
+        const float maxGain = 0.9999f / juce::jmax(static_cast<float>(comb.feedback), 0.0001f);
+
+        const float lowGain = juce::jmin(maxGain, std::pow(10.0f, -3.0f * delaySeconds * lowRate));
+        const float highGain = juce::jmin(maxGain, std::pow(10.0f, -3.0f * delaySeconds * highRate));
+
+        comb.setShelves(lowCoeff, highCoeff, lowGain, highGain);
+    };
+
+    for (auto& c : combsL) applyTo(c);
+    for (auto& c : combsR) applyTo(c);
 
-    DBG("Feedback updated: " << baseFeedback << " for decayTime: " << decayTime);
+    DBG("Decay shelves updated: low x" << lowDecayMultiplier << ", high x" << highDecayMultiplier);
 }
 
-void ReverbProcessor::updateDamping() {
-    // Separate damping for low and high frequencies
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::updateDamping() {
+    // Broadband HF damping; per-band decay times are set by the comb shelves
     float lpDamp = damping * 0.9f;
-    float hpDamp = 0.1f + damping * 0.4f;
 
     for (auto& c : combsL) c.setDamp(lpDamp);
     for (auto& c : combsR) c.setDamp(lpDamp);
 
-    DBG("Damping updated: LP=" << lpDamp << ", HP=" << hpDamp);
+    DBG("Damping updated: LP=" << lpDamp);
 }
 
-void ReverbProcessor::updateDiffusion() {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::updateDiffusion() {
     float earlyCoeff = diffusion * 0.6f;
     float tailCoeff = reverbDiffusion * 0.6f;
 
     earlyCoeff = juce::jlimit(0.01f, 0.999f, earlyCoeff);
     tailCoeff = juce::jlimit(0.01f, 0.999f, tailCoeff);
 
-    for (size_t i = 0; i < allpassesL.size(); ++i) {
+    for (int i = 0; i < allpassesL.getNumStages(); ++i) {
         float coeff = (i < 2) ? earlyCoeff : tailCoeff;
-        allpassesL[i].setCoeff(coeff);
-        allpassesR[i].setCoeff(coeff);
+        allpassesL.setCoeff(i, coeff);
+        allpassesR.setCoeff(i, coeff);
     }
 
     DBG("Diffusion updated: early=" << earlyCoeff << ", tail=" << tailCoeff);
 }
 
-void ReverbProcessor::updatePreDelay() {
-    int maxPreDelay = msToSamples(500.0f);
-    if (maxPreDelay < 1) maxPreDelay = 1;
-
-    // Only resize if needed
-    if (static_cast<int>(preDelayL.buffer.size()) < maxPreDelay) {
-        preDelayL.setSize(maxPreDelay);
-        preDelayR.setSize(maxPreDelay);
-    }
-
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::updatePreDelay() {
+    // Buffers were sized for maxPreDelayMs in reserveMaxSizes()
     int delaySamples = msToSamples(preDelayMs);
     preDelayL.setDelay(delaySamples);
     preDelayR.setDelay(delaySamples);
@@ -707,7 +1689,8 @@ void ReverbProcessor::updatePreDelay() {
     DBG("Pre-delay updated: " << preDelayMs << "ms (" << delaySamples << " samples)");
 }
 
-void ReverbProcessor::updateTieLevel() {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::updateTieLevel() {
     // Calculate HF level gain
     tieLevelGain = 0.5f + tieLevel * 1.5f;
     tieLevelGain = juce::jlimit(0.0f, 3.0f, tieLevelGain);
@@ -715,7 +1698,8 @@ void ReverbProcessor::updateTieLevel() {
     DBG("Tie level updated: " << tieLevel << " -> gain: " << tieLevelGain);
 }
 
-void ReverbProcessor::updateReflectionDelays() {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::updateReflectionDelays() {
     for (size_t t = 0; t < earlyTaps.size() && t < earlyTapDelaysMs.size(); ++t) {
         float delayMs = earlyTapDelaysMs[t] * roomSize * reflectionDelay;
         int delaySamplesL = msToSamples(delayMs);
@@ -726,11 +1710,12 @@ void ReverbProcessor::updateReflectionDelays() {
     }
 }
 
-void ReverbProcessor::updateSubsequentDelays() {
+template <typename SampleType, typename Topology>
+void ReverbProcessor<SampleType, Topology>::updateSubsequentDelays() {
     for (size_t i = 0; i < combsL.size() && i < baseCombDelaysMs.size(); ++i) {
         float delayMs = baseCombDelaysMs[i] * roomSize * subsequentReverbDelay;
-        int delaySamplesL = msToSamples(delayMs);
-        int delaySamplesR = msToSamples(delayMs * 1.02f);
+        int delaySamplesL = msToTailSamples(delayMs);
+        int delaySamplesR = msToTailSamples(delayMs * 1.02f);
 
         // Only resize if needed
         if (static_cast<int>(combsL[i].buffer.size()) != delaySamplesL) {
@@ -743,6 +1728,476 @@ void ReverbProcessor::updateSubsequentDelays() {
     updateFeedback();
 }
 
+//==============================================================================
+// ReverbVoiceManager Implementation
+//==============================================================================
+
+template <typename SampleType>
+ReverbVoiceManager<SampleType>::ReverbVoiceManager(ReverbNetworkSize size)
+    : active(createReverbVoice<SampleType>(size)),
+      standby(createReverbVoice<SampleType>(size)) {}
+
+template <typename SampleType>
+void ReverbVoiceManager<SampleType>::prepare(double sampleRate, int maxBlockSize) {
+    active->prepare(sampleRate);
+    standby->prepare(sampleRate);
+    active->reserveParallelRendering(maxBlockSize);
+    standby->reserveParallelRendering(maxBlockSize);
+
+    tailBuffer.setSize(2, juce::jmax(1, maxBlockSize));
+    fadeLength = juce::jmax(1, static_cast<int>(sampleRate * tailFadeSeconds));
+    fadeRemaining = 0;
+
+    crossfadeBuffer.setSize(2, juce::jmax(1, maxBlockSize));
+    crossfadeLength = juce::jmax(1, static_cast<int>(sampleRate * crossfadeSeconds));
+    crossfadeRemaining = 0;
+}
+
+template <typename SampleType>
+void ReverbVoiceManager<SampleType>::clear() {
+    active->clear();
+    standby->clear();
+    fadeRemaining = 0;
+}
+
+template <typename SampleType>
+void ReverbVoiceManager<SampleType>::resetWithFade() {
+    active->resetWithFade();
+    if (isSwitching())
+        standby->resetWithFade();
+}
+
+template <typename SampleType>
+bool ReverbVoiceManager<SampleType>::switchTo(const ReverbParameters& params) {
+    if (isSwitching())
+        return false;
+
+    // Standby buffers were reserved in prepare(), so resizing here is allocation-free
+    standby->clear();
+    standby->setParameters(params);
+    standby->inheritSmootherState(*active);
+
+    std::swap(active, standby);
+    fadeRemaining = fadeLength;
+
+    active->setTailAnalyser(tailAnalyser);
+    standby->setTailAnalyser(nullptr);
+
+    DBG("Switched reverb voice, fading previous tail over " << fadeLength << " samples");
+    return true;
+}
+
+template <typename SampleType>
+void ReverbVoiceManager<SampleType>::process(SampleType* left, SampleType* right, int numSamples) {
+    active->processStereo(left, right, numSamples);
+
+    // Outgoing voice: no new input, its wet tail fades out on top of the new voice
+    for (int offset = 0; offset < numSamples && fadeRemaining > 0;) {
+        const int n = juce::jmin(numSamples - offset, tailBuffer.getNumSamples(), fadeRemaining);
+
+        tailBuffer.clear(0, 0, n);
+        tailBuffer.clear(1, 0, n);
+        standby->processStereo(tailBuffer.getWritePointer(0), tailBuffer.getWritePointer(1), n);
+
+        const SampleType startGain = static_cast<SampleType>(fadeRemaining) / fadeLength;
+        const SampleType endGain = static_cast<SampleType>(fadeRemaining - n) / fadeLength;
+        tailBuffer.applyGainRamp(0, n, startGain, endGain);
+
+        juce::FloatVectorOperations::add(left + offset, tailBuffer.getReadPointer(0), n);
+        juce::FloatVectorOperations::add(right + offset, tailBuffer.getReadPointer(1), n);
+
+        fadeRemaining -= n;
+        offset += n;
+    }
+}
+
+template <typename SampleType>
+bool ReverbVoiceManager<SampleType>::processCrossfade(ReverbVoiceManager* outgoing,
+    SampleType* left, SampleType* right, int numSamples) {
+    int offset = 0;
+
+    // Both engines see the same input; their outputs (dry included) are
+    // crossfaded so the gains always sum to one
+    while (offset < numSamples && crossfadeRemaining > 0) {
+        const int n = juce::jmin(numSamples - offset, crossfadeBuffer.getNumSamples(), crossfadeRemaining);
+
+        crossfadeBuffer.copyFrom(0, 0, left + offset, n);
+        crossfadeBuffer.copyFrom(1, 0, right + offset, n);
+        if (outgoing != nullptr) {
+            outgoing->process(crossfadeBuffer.getWritePointer(0), crossfadeBuffer.getWritePointer(1), n);
+        }
+        process(left + offset, right + offset, n);
+
+        SampleType gain = static_cast<SampleType>(crossfadeRemaining) / crossfadeLength;
+        const SampleType step = SampleType(1) / crossfadeLength;
+        const SampleType* oldL = crossfadeBuffer.getReadPointer(0);
+        const SampleType* oldR = crossfadeBuffer.getReadPointer(1);
+        for (int i = 0; i < n; ++i) {
+            left[offset + i] += (oldL[i] - left[offset + i]) * gain;
+            right[offset + i] += (oldR[i] - right[offset + i]) * gain;
+            gain -= step;
+        }
+
+        crossfadeRemaining -= n;
+        offset += n;
+    }
+
+    if (offset < numSamples) {
+        process(left + offset, right + offset, numSamples - offset);
+    }
+    return crossfadeRemaining <= 0;
+}
+
+#if DRMK_ENABLE_PROFILING
+template <typename SampleType>
+void ReverbVoiceManager<SampleType>::setProfiler(ReverbProfiler* p) {
+    active->setProfiler(p);
+    standby->setProfiler(p);
+}
+#endif
+
+template <typename SampleType>
+void ReverbVoiceManager<SampleType>::setTailAnalyser(TailAnalyser* a) {
+    tailAnalyser = a;
+    active->setTailAnalyser(a);
+    standby->setTailAnalyser(nullptr);
+}
+
+template <typename SampleType>
+void ReverbVoiceManager<SampleType>::setRenderPool(juce::ThreadPool* pool) {
+    active->setRenderPool(pool);
+    standby->setRenderPool(pool);
+}
+
+template <typename SampleType>
+void ReverbVoiceManager<SampleType>::setLateNetworkHelper(LateNetworkHelper* helper) {
+    active->setLateNetworkHelper(helper);
+    standby->setLateNetworkHelper(helper);
+}
+
+template <typename SampleType>
+void ReverbVoiceManager<SampleType>::setSidechain(const SampleType* left, const SampleType* right) {
+    active->setSidechain(left, right);
+    standby->setSidechain(left, right);
+}
+
+template <typename SampleType>
+size_t ReverbVoiceManager<SampleType>::getMemoryBytes() const {
+    const size_t bufferSamples = static_cast<size_t>(tailBuffer.getNumChannels() * tailBuffer.getNumSamples()
+        + crossfadeBuffer.getNumChannels() * crossfadeBuffer.getNumSamples());
+
+    return sizeof(*this) + active->getMemoryBytes() + standby->getMemoryBytes()
+        + bufferSamples * sizeof(SampleType);
+}
+
+template <typename SampleType>
+std::unique_ptr<ReverbVoice<SampleType>> createReverbVoice(ReverbNetworkSize size) {
+    switch (size) {
+        case ReverbNetworkSize::lite: return std::make_unique<ReverbProcessor<SampleType, LiteTopology>>();
+        case ReverbNetworkSize::dense: return std::make_unique<ReverbProcessor<SampleType, DenseTopology>>();
+        case ReverbNetworkSize::standard:
+        default: return std::make_unique<ReverbProcessor<SampleType, StandardTopology>>();
+    }
+}
+
+template class ReverbProcessor<float, LiteTopology>;
+template class ReverbProcessor<float, StandardTopology>;
+template class ReverbProcessor<float, DenseTopology>;
+template class ReverbProcessor<double, LiteTopology>;
+template class ReverbProcessor<double, StandardTopology>;
+template class ReverbProcessor<double, DenseTopology>;
+template std::unique_ptr<ReverbVoice<float>> createReverbVoice<float>(ReverbNetworkSize);
+template std::unique_ptr<ReverbVoice<double>> createReverbVoice<double>(ReverbNetworkSize);
+template class ReverbVoiceManager<float>;
+template class ReverbVoiceManager<double>;
+
+//==============================================================================
+// ReverbEngineHolder Implementation
+//==============================================================================
+
+// Allocates and prepares a whole engine off the audio and message threads,
+// then publishes it through the instance's slot. prepareToPlay's job can also
+// be claimed by the audio thread (finishStartup), so whichever gets there first
+// does the work, once.
+template <typename SampleType>
+class ReverbEngineHolder<SampleType>::PrepareJob : public juce::ThreadPoolJob {
+public:
+    PrepareJob(std::shared_ptr<PreparedSlot> s, std::unique_ptr<Engine> e, double sr, int blockSize)
+        : juce::ThreadPoolJob("DRMKII engine prepare"), slot(std::move(s)), engine(std::move(e)),
+          sampleRate(sr), maxBlockSize(blockSize) {}
+
+    JobStatus runJob() override {
+        if (claim()) {
+            const int generation = engine->getGeneration();
+            engine->prepare(sampleRate, maxBlockSize);
+            slot->publish(engine, generation);
+            state.store(done, std::memory_order_release);
+        }
+        return jobHasFinished;
+    }
+
+    // Audio thread: the engine, prepared here if the pool had not started on
+    // it. Null once the pool has published it (waiting for that if it is
+    // still preparing) or if the request has been superseded.
+    std::unique_ptr<Engine> takeOver() {
+        if (!claim()) {
+            while (state.load(std::memory_order_acquire) != done)
+                std::this_thread::yield();
+            return {};
+        }
+
+        engine->prepare(sampleRate, maxBlockSize);
+        state.store(done, std::memory_order_release);
+        return std::move(engine);
+    }
+
+private:
+    enum State { queued = 0, claimed, done };
+
+    bool claim() {
+        int expected = queued;
+        if (!state.compare_exchange_strong(expected, claimed, std::memory_order_acq_rel)) return false;
+
+        // A newer request has superseded this one
+        if (engine->getGeneration() != slot->generation.load(std::memory_order_acquire)) {
+            state.store(done, std::memory_order_release);
+            return false;
+        }
+        return true;
+    }
+
+    std::shared_ptr<PreparedSlot> slot;
+    std::unique_ptr<Engine> engine;  // Left here, and freed with the job, if superseded
+    double sampleRate;
+    int maxBlockSize;
+    std::atomic<int> state{ queued };
+};
+
+template <typename SampleType>
+ReverbEngineHolder<SampleType>::ReverbEngineHolder() = default;
+
+template <typename SampleType>
+ReverbEngineHolder<SampleType>::~ReverbEngineHolder() {
+    release();
+}
+
+template <typename SampleType>
+void ReverbEngineHolder<SampleType>::startPrepare(juce::ThreadPool& pool, std::unique_ptr<Engine> newEngine,
+    double sampleRate, int maxBlockSize) {
+    release();
+    newEngine->setGeneration(prepared->nextGeneration());
+    startupJob = std::make_unique<PrepareJob>(prepared, std::move(newEngine), sampleRate, maxBlockSize);
+    startupPool = &pool;
+    pool.addJob(startupJob.get(), false);
+}
+
+template <typename SampleType>
+bool ReverbEngineHolder<SampleType>::finishStartup() {
+    if (engine != nullptr || pending != nullptr || startupJob == nullptr) return false;
+
+    pending = startupJob->takeOver();
+    return takePrepared();
+}
+
+template <typename SampleType>
+void ReverbEngineHolder<SampleType>::requestPrepare(juce::ThreadPool& pool, std::unique_ptr<Engine> newEngine,
+    double sampleRate, int maxBlockSize, bool crossfade) {
+    newEngine->setFadesIn(crossfade);
+    newEngine->setGeneration(prepared->nextGeneration());
+    pool.addJob(new PrepareJob(prepared, std::move(newEngine), sampleRate, maxBlockSize), true);
+}
+
+template <typename SampleType>
+void ReverbEngineHolder<SampleType>::prepareNow(std::unique_ptr<Engine> newEngine, double sampleRate, int maxBlockSize,
+    bool crossfade) {
+    newEngine->setFadesIn(crossfade);
+    const int generation = prepared->nextGeneration();  // Supersedes any job still in flight
+    newEngine->setGeneration(generation);
+    newEngine->prepare(sampleRate, maxBlockSize);
+    prepared->publish(newEngine, generation);
+}
+
+template <typename SampleType>
+bool ReverbEngineHolder<SampleType>::takePrepared() {
+    bool retiredAny = false;
+
+    // Own the engine before looking at it: other threads may replace whatever
+    // is still in the slot. A newer engine supersedes one still waiting here.
+    if (prepared->engine.load(std::memory_order_relaxed) != nullptr) {
+        if (pending != nullptr) retiredAny = retire(pending);
+        if (pending == nullptr) pending.reset(prepared->engine.exchange(nullptr, std::memory_order_acq_rel));
+    }
+    if (pending == nullptr) return retiredAny;
+
+    // Prepared for a request that has since been superseded
+    if (pending->getGeneration() != prepared->generation.load(std::memory_order_acquire)) {
+        return retire(pending) || retiredAny;
+    }
+
+    // Crossfade: the running engine becomes the outgoing one and is retired
+    // by process() once it has faded; with none running (waking from
+    // hibernation) the new engine fades in over the dry signal. One crossfade
+    // at a time.
+    if (pending->isFadingIn()) {
+        if (outgoing != nullptr) return retiredAny;
+
+        if (engine != nullptr) {
+            outgoing = std::move(engine);
+            outgoing->setTailAnalyser(nullptr);
+        }
+        engine = std::move(pending);
+        engine->startCrossfade();
+        updateMemoryBytes();
+        return retiredAny;
+    }
+
+    // Only swap when the old engine has somewhere to go, so it is never freed here
+    if (engine != nullptr) {
+        if (!retire(engine)) return retiredAny;
+        retiredAny = true;
+    }
+    engine = std::move(pending);
+    updateMemoryBytes();
+    return retiredAny;
+}
+
+template <typename SampleType>
+bool ReverbEngineHolder<SampleType>::retire(std::unique_ptr<Engine>& oldEngine) {
+    for (auto& slot : retired) {
+        if (slot.load(std::memory_order_acquire) != nullptr) continue;
+        slot.store(oldEngine.release(), std::memory_order_release);
+        return true;
+    }
+    return false;
+}
+
+template <typename SampleType>
+bool ReverbEngineHolder<SampleType>::process(SampleType* left, SampleType* right, int numSamples) {
+    if (engine->isCrossfading()) {
+        if (!engine->processCrossfade(outgoing.get(), left, right, numSamples)) return false;
+    }
+    else {
+        engine->process(left, right, numSamples);
+    }
+
+    // No free slot yet: keep it, silent, until the next block
+    if (outgoing == nullptr || !retire(outgoing)) return false;
+
+    updateMemoryBytes();
+    return true;
+}
+
+template <typename SampleType>
+bool ReverbEngineHolder<SampleType>::hibernate() {
+    bool retiredAny = false;
+
+    for (auto* owner : { &pending, &outgoing, &engine }) {
+        if (*owner != nullptr && retire(*owner)) retiredAny = true;
+    }
+    updateMemoryBytes();
+    return retiredAny;
+}
+
+template <typename SampleType>
+void ReverbEngineHolder<SampleType>::setSidechain(const SampleType* left, const SampleType* right) {
+    if (engine != nullptr) engine->setSidechain(left, right);
+    if (outgoing != nullptr) outgoing->setSidechain(left, right);
+}
+
+template <typename SampleType>
+void ReverbEngineHolder<SampleType>::resetWithFade() {
+    if (engine != nullptr) engine->resetWithFade();
+    if (outgoing != nullptr) outgoing->resetWithFade();
+}
+
+template <typename SampleType>
+void ReverbEngineHolder<SampleType>::updateMemoryBytes() {
+    memoryBytes.store((engine != nullptr ? engine->getMemoryBytes() : 0)
+        + (outgoing != nullptr ? outgoing->getMemoryBytes() : 0), std::memory_order_relaxed);
+}
+
+template <typename SampleType>
+void ReverbEngineHolder<SampleType>::freeRetired() {
+    for (auto& slot : retired) {
+        delete slot.exchange(nullptr, std::memory_order_acq_rel);
+    }
+}
+
+template <typename SampleType>
+void ReverbEngineHolder<SampleType>::release() {
+    // prepareToPlay's job may still be running on the pool
+    if (startupJob != nullptr) {
+        startupPool->removeJob(startupJob.get(), true, -1);
+        startupJob.reset();
+    }
+
+    // Discard any prepare job still in flight
+    prepared->nextGeneration();
+    delete prepared->engine.exchange(nullptr, std::memory_order_acq_rel);
+    freeRetired();
+    pending.reset();
+    outgoing.reset();
+    engine.reset();
+    memoryBytes.store(0);
+}
+
+template class ReverbEngineHolder<float>;
+template class ReverbEngineHolder<double>;
+
+//==============================================================================
+// Factory Programs
+//==============================================================================
+
+namespace {
+    // Values in ReverbParameters order:
+    // decay, predelay, damping, diffusion, revdiff,
+    // size, volume, early, refdelay, subdelay,
+    // sublevel, envelop, position, reflect, tielevel,
+    // mix, lowdecay, highdecay, inputdiff, duck,
+    // duckatk, duckrel, mode, gatelen, freeze
+    const ReverbProgram factoryPrograms[] = {
+        { "Default", {} },
+        { "Small Room", { { 0.6f, 5.0f, 0.6f, 0.6f, 0.6f,
+                            0.4f, 1.0f, 0.5f, 0.8f, 0.8f,
+                            0.6f, 0.6f, 0.5f, 0.7f, 0.4f,
+                            0.3f, 1.0f, 0.8f, 0.3f, 0.0f,
+                            5.0f, 200.0f, 0.0f, 300.0f, 0.0f } } },
+        { "Vocal Plate", { { 1.8f, 15.0f, 0.35f, 0.8f, 0.85f,
+                             0.6f, 1.0f, 0.2f, 1.0f, 1.0f,
+                             0.8f, 0.9f, 0.5f, 0.85f, 0.7f,
+                             0.3f, 0.9f, 1.0f, 0.6f, 0.0f,
+                             5.0f, 200.0f, 0.0f, 300.0f, 0.0f } } },
+        { "Drum Chamber", { { 1.2f, 8.0f, 0.5f, 0.75f, 0.7f,
+                              0.8f, 1.0f, 0.45f, 0.9f, 0.9f,
+                              0.7f, 0.7f, 0.5f, 0.8f, 0.5f,
+                              0.25f, 1.0f, 0.8f, 0.4f, 0.0f,
+                              5.0f, 200.0f, 0.0f, 300.0f, 0.0f } } },
+        { "Concert Hall", { { 3.2f, 30.0f, 0.45f, 0.7f, 0.75f,
+                              1.3f, 1.0f, 0.3f, 1.2f, 1.2f,
+                              0.85f, 0.85f, 0.5f, 0.85f, 0.5f,
+                              0.35f, 1.2f, 0.7f, 0.5f, 0.0f,
+                              5.0f, 200.0f, 0.0f, 300.0f, 0.0f } } },
+        { "Cathedral", { { 7.5f, 60.0f, 0.55f, 0.8f, 0.8f,
+                           1.9f, 1.0f, 0.25f, 1.6f, 1.8f,
+                           0.9f, 0.95f, 0.5f, 0.9f, 0.45f,
+                           0.4f, 1.3f, 0.6f, 0.7f, 0.0f,
+                           5.0f, 200.0f, 0.0f, 300.0f, 0.0f } } },
+        { "Ambient Wash", { { 10.0f, 120.0f, 0.3f, 0.9f, 0.9f,
+                              1.6f, 1.0f, 0.1f, 1.5f, 1.6f,
+                              1.0f, 1.0f, 0.5f, 0.95f, 0.6f,
+                              0.6f, 1.2f, 0.8f, 0.8f, 0.0f,
+                              5.0f, 200.0f, 0.0f, 300.0f, 0.0f } } }
+    };
+}
+
+int DSP256XLReverbProcessor::getNumFactoryPrograms() {
+    return static_cast<int>(std::size(factoryPrograms));
+}
+
+const ReverbProgram& DSP256XLReverbProcessor::getFactoryProgram(int index) {
+    return factoryPrograms[juce::jlimit(0, getNumFactoryPrograms() - 1, index)];
+}
+
 //==============================================================================
 // DSP256XLReverbProcessor Implementation
 //==============================================================================
@@ -865,49 +2320,230 @@ juce::AudioProcessorValueTreeState::ParameterLayout DSP256XLReverbProcessor::cre
         juce::AudioProcessorParameter::genericParameter,
         [](float value, int) { return juce::String(value * 100, 0) + "%"; }));
 
+    // Band Decay (multiples of the decay time below 250Hz and above 4kHz)
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("lowdecay", 1), "Low Decay",
+        juce::NormalisableRange<float>(0.25f, 4.0f, 0.01f, 0.5f), 1.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(value, 2) + "x"; }));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("highdecay", 1), "High Decay",
+        juce::NormalisableRange<float>(0.1f, 2.0f, 0.01f, 0.6f), 1.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(value, 2) + "x"; }));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("inputdiff", 1), "Input Diffusion",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
+
+    // Ducking: turns the wet signal down under the sidechain, or the dry
+    // input when no sidechain is connected
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("duck", 1), "Ducking",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("duckatk", 1), "Duck Attack",
+        juce::NormalisableRange<float>(0.1f, 100.0f, 0.1f, 0.4f), 5.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(value, 1) + "ms"; }));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("duckrel", 1), "Duck Release",
+        juce::NormalisableRange<float>(10.0f, 2000.0f, 1.0f, 0.4f), 200.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(value, 0) + "ms"; }));
+
+    // Holds the current tail indefinitely
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID("freeze", 1), "Freeze", false));
+
+    // Late-output mode, in ReverbMode order, and its gate/segment length
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("mode", 1), "Mode",
+        juce::StringArray{ "Normal", "Gated", "Reverse" }, static_cast<int>(ReverbMode::normal)));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("gatelen", 1), "Gate Length",
+        juce::NormalisableRange<float>(50.0f, 1000.0f, 1.0f, 0.6f), 300.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(value, 0) + "ms"; }));
+
+    // Engine quality, in ReverbNetworkSize order; not part of the programs
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("quality", 1), "Quality",
+        juce::StringArray{ "Eco", "Normal", "High" }, static_cast<int>(ReverbNetworkSize::standard)));
+
     return layout;
 }
 
 DSP256XLReverbProcessor::DSP256XLReverbProcessor()
     : AudioProcessor(BusesProperties()
         .withInput("Input", juce::AudioChannelSet::stereo(), true)
+        .withInput("Sidechain", juce::AudioChannelSet::stereo(), false)
         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , apvts(*this, nullptr, "Parameters", createParameterLayout())
 {
-    // Ensure reverb processor matches APVTS defaults
-    reverb.setDecayTime(2.0f);
-    reverb.setPreDelay(20.0f);
-    reverb.setDamping(0.5f);
-    reverb.setDiffusion(0.7f);
-    reverb.setReverbDiffusion(0.7f);
-    reverb.setRoomSize(0.75f);
-    reverb.setRoomVolume(1.0f);
-    reverb.setEarlyReflectionLevel(0.3f);
-    reverb.setReflectionDelay(1.0f);
-    reverb.setSubsequentReverbDelay(1.0f);
-    reverb.setSubsequentLevel(0.8f);
-    reverb.setEnvelopment(0.8f);
-    reverb.setNormalizedReflectivity(0.8f);
-    reverb.setTieLevel(0.5f);
-    reverb.setPosition(0.5f);
-    reverb.setDryWet(0.5f);
+    for (int i = 0; i < ReverbParameters::numParameters; ++i) {
+        rawParameters[static_cast<size_t>(i)] = apvts.getRawParameterValue(ReverbParameters::getID(i));
+        jassert(rawParameters[static_cast<size_t>(i)] != nullptr);
+    }
+
+    qualityParameter = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("quality"));
+    jassert(qualityParameter != nullptr);
 
     DBG("DSP256XLReverbProcessor constructed with " <<
         apvts.getParameter("decay")->getValue() << " decay");
 }
 
+DSP256XLReverbProcessor::~DSP256XLReverbProcessor() {
+    cancelPendingUpdate();
+
+    // While the shared pool is still there to take back a startup job
+    floatEngine.release();
+    doubleEngine.release();
+}
+
+template <typename SampleType>
+ReverbEngineHolder<SampleType>& DSP256XLReverbProcessor::getEngine() {
+    if constexpr (std::is_same_v<SampleType, double>) {
+        return doubleEngine;
+    }
+    else {
+        return floatEngine;
+    }
+}
+
 void DSP256XLReverbProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     if (sampleRate <= 0.0) {
         DBG("ERROR: prepareToPlay called with invalid sample rate: " << sampleRate);
         sampleRate = 44100.0;
     }
 
-    reverb.prepare(sampleRate);
+#if DRMK_ENABLE_PROFILING
+    profiler.setSampleRate(sampleRate);
+#endif
+    tailAnalyser.setSampleRate(sampleRate);
+
+    const juce::ScopedLock sl(engineLock);
+
+    const bool useDouble = isUsingDoublePrecision();
+    hibernating.store(false);
+    wakeRequested.store(false);
+    bypassedSamples = 0;
+    networkSize = static_cast<ReverbNetworkSize>(qualityParameter->getIndex());
+    requestedQuality.store(qualityParameter->getIndex());
+
+    // Only the precision the host processes in keeps an engine, and it is
+    // ready before the first block
+    if (useDouble) {
+        floatEngine.release();
+        prepareEngine<double>(sampleRate, samplesPerBlock);
+    }
+    else {
+        doubleEngine.release();
+        prepareEngine<float>(sampleRate, samplesPerBlock);
+    }
+
+    requestedSampleRate = sampleRate;
+    requestedBlockSize = samplesPerBlock;
+    requestedDoublePrecision = useDouble;
+    requestedNetworkSize = networkSize;
+
+    DBG("Prepared to play at " << sampleRate << "Hz, block size: " << samplesPerBlock
+        << (useDouble ? ", double precision" : ", single precision"));
+}
+
+template <typename SampleType>
+std::unique_ptr<ReverbVoiceManager<SampleType>> DSP256XLReverbProcessor::createEngine() {
+    auto engine = std::make_unique<ReverbVoiceManager<SampleType>>(networkSize);
+    engine->getActive().setParameters(readParameters());
+#if DRMK_ENABLE_PROFILING
+    engine->setProfiler(&profiler);
+#endif
+    engine->setTailAnalyser(&tailAnalyser);
+    return engine;
+}
+
+template <typename SampleType>
+void DSP256XLReverbProcessor::prepareEngine(double sampleRate, int samplesPerBlock) {
+    auto& holder = getEngine<SampleType>();
+
+    // Same configuration as the engine already requested: just reset it
+    if (holder.get() != nullptr && sampleRate == requestedSampleRate && samplesPerBlock <= requestedBlockSize
+        && requestedDoublePrecision == std::is_same_v<SampleType, double>
+        && requestedNetworkSize == networkSize) {
+        holder.get()->clear();
+        return;
+    }
+
+    // The audio thread is stopped, so the old engine goes now and never runs
+    // at the old configuration. The new one is prepared on the shared pool, in
+    // parallel with every other instance the host is preparing; a first block
+    // that arrives before the pool has started on it builds it in place.
+    holder.startPrepare(preparationPool->pool, createEngine<SampleType>(), sampleRate, samplesPerBlock);
+}
+
+template <typename SampleType>
+void DSP256XLReverbProcessor::rebuildEngine(bool buildNow) {
+    auto& holder = getEngine<SampleType>();
+    auto engine = createEngine<SampleType>();
 
-    DBG("Prepared to play at " << sampleRate << "Hz, block size: " << samplesPerBlock);
+    if (buildNow) {
+        holder.prepareNow(std::move(engine), requestedSampleRate, requestedBlockSize, true);
+    }
+    else {
+        holder.requestPrepare(preparationPool->pool, std::move(engine), requestedSampleRate, requestedBlockSize, true);
+    }
 }
 
 void DSP256XLReverbProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) {
+    processBlockInternal(buffer);
+}
+
+void DSP256XLReverbProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&) {
+    processBlockInternal(buffer);
+}
+
+void DSP256XLReverbProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) {
+    processBlockBypassedInternal(buffer);
+}
+
+void DSP256XLReverbProcessor::processBlockBypassed(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&) {
+    processBlockBypassedInternal(buffer);
+}
+
+template <typename SampleType>
+void DSP256XLReverbProcessor::processBlockBypassedInternal(juce::AudioBuffer<SampleType>& buffer) {
+    // The dry signal passes through untouched. Once the tail the host would
+    // have heard is long gone, hand the engine back for freeing.
+    if (hibernating.load(std::memory_order_relaxed)) return;
+
+    // A frozen tail never runs out, so keep the engine for when bypass ends
+    if (rawParameters[static_cast<size_t>(ReverbParameters::freeze)]->load() >= 0.5f) {
+        bypassedSamples = 0;
+        return;
+    }
+
+    bypassedSamples += buffer.getNumSamples();
+    const double hibernateSeconds = juce::jmax(minHibernateSeconds, getTailLengthSeconds());
+    if (bypassedSamples < static_cast<int>(getSampleRate() * hibernateSeconds)) return;
+
+    hibernating.store(true, std::memory_order_relaxed);
+    if (getEngine<SampleType>().hibernate()) {
+        triggerAsyncUpdate();
+    }
+    DBG("Hibernating after " << bypassedSamples << " bypassed samples");
+}
+
+template <typename SampleType>
+void DSP256XLReverbProcessor::processBlockInternal(juce::AudioBuffer<SampleType>& buffer) {
     juce::ScopedNoDenormals noDenormals;
 
     if (buffer.getNumChannels() < 2) {
@@ -915,36 +2551,193 @@ void DSP256XLReverbProcessor::processBlock(juce::AudioBuffer<float>& buffer, juc
         return;
     }
 
-    // Get all parameters from APVTS
-    reverb.setDecayTime(apvts.getRawParameterValue("decay")->load());
-    reverb.setPreDelay(apvts.getRawParameterValue("predelay")->load());
-    reverb.setDamping(apvts.getRawParameterValue("damping")->load());
-    reverb.setDiffusion(apvts.getRawParameterValue("diffusion")->load());
-    reverb.setReverbDiffusion(apvts.getRawParameterValue("revdiff")->load());
-    reverb.setRoomSize(apvts.getRawParameterValue("size")->load());
-    reverb.setRoomVolume(apvts.getRawParameterValue("volume")->load());
-    reverb.setEarlyReflectionLevel(apvts.getRawParameterValue("early")->load());
-    reverb.setReflectionDelay(apvts.getRawParameterValue("refdelay")->load());
-    reverb.setSubsequentReverbDelay(apvts.getRawParameterValue("subdelay")->load());
-    reverb.setSubsequentLevel(apvts.getRawParameterValue("sublevel")->load());
-    reverb.setEnvelopment(apvts.getRawParameterValue("envelop")->load());
-    reverb.setPosition(apvts.getRawParameterValue("position")->load());
-    reverb.setNormalizedReflectivity(apvts.getRawParameterValue("reflect")->load());
-    reverb.setTieLevel(apvts.getRawParameterValue("tielevel")->load());
-    reverb.setDryWet(apvts.getRawParameterValue("mix")->load());
+    DRMK_PROFILE_BLOCK(&profiler, buffer.getNumSamples());
+
+    // Back from bypass: the engine needs rebuilding
+    bypassedSamples = 0;
+    if (hibernating.load(std::memory_order_relaxed)) {
+        hibernating.store(false, std::memory_order_relaxed);
+        wakeRequested.store(true, std::memory_order_release);
+    }
+
+    // Woken or quality changed: offline, rebuild right here; in real time the
+    // message thread has the new engine prepared on the pool
+    if (wakeRequested.load(std::memory_order_acquire)
+        || qualityParameter->getIndex() != requestedQuality.load(std::memory_order_relaxed)) {
+        if (isNonRealtime()) {
+            updateEngine(true);
+        }
+        else {
+            triggerAsyncUpdate();
+        }
+    }
+
+    auto& holder = getEngine<SampleType>();
+    if (holder.takePrepared()) {
+        triggerAsyncUpdate();
+    }
+
+    // First block after prepareToPlay: never processed dry, whatever the pool is doing
+    if (holder.get() == nullptr && holder.finishStartup()) {
+        triggerAsyncUpdate();
+    }
+
+    // Host transport reset: fade out and clear whatever is still ringing
+    if (resetRequested.exchange(false, std::memory_order_acq_rel)) {
+        holder.resetWithFade();
+    }
+
+    // Waking from hibernation: pass the dry signal through until the engine is ready
+    auto* reverb = holder.get();
+    if (reverb == nullptr) return;
+
+    // Pick up a program change from the host. While the switch waits for the
+    // previous one to fade, host values stay queued in the APVTS rather than
+    // going to the outgoing voice, which would be resized underneath its tail;
+    // the new voice starts from them, automation included.
+    ReverbParameters hostParameters;
+    const bool hostParametersValid = readHostParameters(hostParameters);
+
+    int program = pendingProgram.load(std::memory_order_acquire);
+    if (program >= 0) {
+        if (!reverb->isSwitching()
+            && pendingProgram.compare_exchange_strong(program, -1, std::memory_order_acq_rel)) {
+            reverb->switchTo(hostParametersValid ? hostParameters : getFactoryProgram(program).params);
+        }
+    }
+    else if (hostParametersValid) {
+        reverb->getActive().setParameters(hostParameters);
+    }
+
+    // Duck under the sidechain when the host has connected one
+    const SampleType* keyL = nullptr;
+    const SampleType* keyR = nullptr;
+    if (auto* sidechain = getBus(true, 1); sidechain != nullptr && sidechain->isEnabled()
+        && sidechain->getNumberOfChannels() > 0) {
+        auto key = getBusBuffer(buffer, true, 1);
+        keyL = key.getReadPointer(0);
+        keyR = key.getReadPointer(key.getNumChannels() > 1 ? 1 : 0);
+    }
+    holder.setSidechain(keyL, keyR);
+
+    // Bounces spread each voice over the shared pool; in real time only the
+    // opt-in helper thread takes a share
+    const bool bouncing = isNonRealtime() && juce::SystemStats::getNumCpus() > 1;
+    reverb->setRenderPool(bouncing ? &renderPool->pool : nullptr);
+    reverb->setLateNetworkHelper(!bouncing && isDualCoreProcessing() ? &lateNetworkHelper : nullptr);
 
     // Process stereo audio
-    float* left = buffer.getWritePointer(0);
-    float* right = buffer.getWritePointer(1);
+    SampleType* left = buffer.getWritePointer(0);
+    SampleType* right = buffer.getWritePointer(1);
+
+    if (holder.process(left, right, buffer.getNumSamples())) {
+        triggerAsyncUpdate();
+    }
+}
+
+void DSP256XLReverbProcessor::updateEngine(bool buildNow) {
+    const juce::ScopedLock sl(engineLock);
+
+    const auto quality = static_cast<ReverbNetworkSize>(qualityParameter->getIndex());
+    requestedQuality.store(static_cast<int>(quality));
+    const bool wake = wakeRequested.exchange(false, std::memory_order_acquire);
+    if (!wake && quality == networkSize) return;
+    networkSize = quality;
+
+    // Nothing to rebuild until the host has prepared us
+    if (requestedSampleRate <= 0.0) return;
+
+    if (requestedDoublePrecision) {
+        rebuildEngine<double>(buildNow);
+    }
+    else {
+        rebuildEngine<float>(buildNow);
+    }
+    requestedNetworkSize = networkSize;
+}
+
+void DSP256XLReverbProcessor::setDualCoreProcessing(bool shouldUseTwoCores) {
+    shouldUseTwoCores = shouldUseTwoCores && juce::SystemStats::getNumCpus() > 1;
+
+    // The helper is running before the audio thread can dispatch to it; once
+    // the flag is cleared, any task still handed over is taken back by join()
+    if (shouldUseTwoCores) {
+        lateNetworkHelper.start();
+        dualCore.store(true);
+    }
+    else {
+        dualCore.store(false);
+        lateNetworkHelper.stop();
+    }
+}
+
+void DSP256XLReverbProcessor::handleAsyncUpdate() {
+    floatEngine.freeRetired();
+    doubleEngine.freeRetired();
+
+    // Offline renders rebuild on the audio thread
+    if (!isNonRealtime()) {
+        updateEngine(false);
+    }
+}
+
+size_t DSP256XLReverbProcessor::getMemoryBytes() const {
+    return sizeof(*this) + floatEngine.getMemoryBytes() + doubleEngine.getMemoryBytes();
+}
+
+bool DSP256XLReverbProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
+    if (layouts.getMainInputChannelSet() != juce::AudioChannelSet::stereo()
+        || layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo()) {
+        return false;
+    }
 
-    reverb.processStereo(left, right, buffer.getNumSamples());
+    if (layouts.inputBuses.size() < 2) return true;
+
+    const auto sidechain = layouts.getChannelSet(true, 1);
+    return sidechain.isDisabled() || sidechain == juce::AudioChannelSet::mono()
+        || sidechain == juce::AudioChannelSet::stereo();
+}
+
+ReverbParameters DSP256XLReverbProcessor::readParameters() const {
+    ReverbParameters params;
+    for (size_t i = 0; i < rawParameters.size(); ++i) {
+        if (rawParameters[i] != nullptr) {
+            params.values[i] = rawParameters[i]->load();
+        }
+    }
+    return params;
+}
+
+bool DSP256XLReverbProcessor::readHostParameters(ReverbParameters& params) const {
+    const int requests = programRequests.load(std::memory_order_acquire);
+    if (programsWritten.load(std::memory_order_acquire) != requests) return false;
+
+    params = readParameters();
+
+    // A program change that started while we were reading may have mixed its
+    // values in
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return programRequests.load(std::memory_order_relaxed) == requests;
 }
 
 void DSP256XLReverbProcessor::releaseResources() {
-    reverb.clear();
+    const juce::ScopedLock sl(engineLock);
+
+    // Suspended: free the engines and their delay memory; the next
+    // prepareToPlay builds a fresh one
+    floatEngine.release();
+    doubleEngine.release();
+    requestedSampleRate = 0.0;
+    requestedBlockSize = 0;
+    hibernating.store(false);
+    wakeRequested.store(false);
     DBG("Resources released");
 }
 
+void DSP256XLReverbProcessor::reset() {
+    resetRequested.store(true, std::memory_order_release);
+}
+
 const juce::String DSP256XLReverbProcessor::getName() const {
     return "DSP-256XL Reverb";
 }
@@ -952,22 +2745,141 @@ const juce::String DSP256XLReverbProcessor::getName() const {
 bool DSP256XLReverbProcessor::acceptsMidi() const { return false; }
 bool DSP256XLReverbProcessor::producesMidi() const { return false; }
 double DSP256XLReverbProcessor::getTailLengthSeconds() const {
-    return apvts.getRawParameterValue("decay")->load() * 2.0;
+    const auto value = [this](int index) { return static_cast<double>(rawParameters[static_cast<size_t>(index)]->load()); };
+
+    // A frozen tail is held until freeze is released
+    if (value(ReverbParameters::freeze) >= 0.5) return std::numeric_limits<double>::infinity();
+
+    // Twice the longest band's decay, after the pre-delay
+    const double decayMultiplier = juce::jmax(1.0, value(ReverbParameters::lowDecay), value(ReverbParameters::highDecay));
+    double seconds = value(ReverbParameters::preDelay) * 0.001 + value(ReverbParameters::decay) * 2.0 * decayMultiplier;
+
+    // Reverse mode plays the tail back up to two gate lengths late
+    if (juce::roundToInt(value(ReverbParameters::mode)) == static_cast<int>(ReverbMode::reverse)) {
+        seconds += value(ReverbParameters::gateLength) * 0.002;
+    }
+    return seconds;
+}
+int DSP256XLReverbProcessor::getNumPrograms() { return getNumFactoryPrograms(); }
+int DSP256XLReverbProcessor::getCurrentProgram() { return currentProgram.load(); }
+
+void DSP256XLReverbProcessor::setCurrentProgram(int index) {
+    if (!juce::isPositiveAndBelow(index, getNumFactoryPrograms())) return;
+
+    currentProgram.store(index);
+
+    // Queue the voice switch before touching the parameters, so the audio thread
+    // stops feeding parameters to the outgoing voice, and keep it away from the
+    // APVTS until every value of the program has been written
+    const int request = programRequests.fetch_add(1, std::memory_order_relaxed) + 1;
+    std::atomic_thread_fence(std::memory_order_release);
+    pendingProgram.store(index, std::memory_order_release);
+
+    const auto& program = getFactoryProgram(index);
+    for (int i = 0; i < ReverbParameters::numParameters; ++i) {
+        if (auto* param = apvts.getParameter(ReverbParameters::getID(i))) {
+            param->setValueNotifyingHost(param->convertTo0to1(program.params[i]));
+        }
+    }
+    programsWritten.store(request, std::memory_order_release);
+
+    DBG("Program changed to " << program.name);
+}
+
+const juce::String DSP256XLReverbProcessor::getProgramName(int index) {
+    return getFactoryProgram(index).name;
 }
-int DSP256XLReverbProcessor::getNumPrograms() { return 1; }
-int DSP256XLReverbProcessor::getCurrentProgram() { return 0; }
-void DSP256XLReverbProcessor::setCurrentProgram(int) {}
-const juce::String DSP256XLReverbProcessor::getProgramName(int) { return "Default"; }
+
 void DSP256XLReverbProcessor::changeProgramName(int, const juce::String&) {}
 
 void DSP256XLReverbProcessor::getStateInformation(juce::MemoryBlock& destData) {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    const auto params = readParameters();
+
+    juce::MemoryOutputStream stream(destData, false);
+    stream.writeInt(stateMagic);
+    stream.writeInt(stateVersion);
+    stream.writeInt(currentProgram.load());
+    stream.writeInt(ReverbParameters::numParameters);
+    for (float v : params.values) {
+        stream.writeFloat(v);
+    }
+    stream.writeInt(isDualCoreProcessing() ? dualCoreFlag : 0);
+    stream.writeInt(qualityParameter->getIndex());
+    stream.flush();
+
     DBG("State saved");
 }
 
 void DSP256XLReverbProcessor::setStateInformation(const void* data, int sizeInBytes) {
+    if (data == nullptr || sizeInBytes <= 0) return;
+
+    // Sessions saved before the binary format hold an XML state
+    if (!readBinaryState(data, sizeInBytes)) {
+        readXmlState(data, sizeInBytes);
+    }
+}
+
+bool DSP256XLReverbProcessor::readBinaryState(const void* data, int sizeInBytes) {
+    constexpr int headerSize = 4 * static_cast<int>(sizeof(int));
+    if (sizeInBytes < headerSize) return false;
+
+    juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
+    if (stream.readInt() != stateMagic) return false;
+
+    const int version = stream.readInt();
+    const int program = stream.readInt();
+    const int numStored = stream.readInt();
+
+    if (version < 1 || numStored < 0 || numStored > maxStoredParameters
+        || sizeInBytes < headerSize + static_cast<juce::int64>(numStored) * static_cast<juce::int64>(sizeof(float))) {
+        DBG("ERROR: Corrupt binary state, version " << version << ", " << numStored << " values");
+        return true;  // Ours, but unreadable: keep the current state
+    }
+
+    // Restored through the value tree like the XML state rather than with a
+    // setValueNotifyingHost per parameter, which hosts record as automation
+    // and undo steps while loading a session. The tree is built from the blob
+    // rather than by editing a copy of the current state, which would cost a
+    // copy plus a child lookup per parameter.
+    juce::ValueTree state(apvts.state.getType());
+    auto addStateValue = [&state](const char* id, float value) {
+        state.appendChild(juce::ValueTree("PARAM").setProperty("id", id, nullptr).setProperty("value", value, nullptr), nullptr);
+    };
+
+    // Values are appended as parameters are added, so newer blobs may carry
+    // more values than we know about and older ones fewer
+    for (int i = 0; i < numStored; ++i) {
+        const float value = stream.readFloat();
+        if (i < ReverbParameters::numParameters) {
+            addStateValue(ReverbParameters::getID(i), value);
+        }
+    }
+    for (int i = numStored; i < ReverbParameters::numParameters; ++i) {
+        if (auto* param = apvts.getParameter(ReverbParameters::getID(i))) {
+            addStateValue(ReverbParameters::getID(i), param->convertFrom0to1(param->getDefaultValue()));
+        }
+    }
+
+    if (juce::isPositiveAndBelow(program, getNumFactoryPrograms())) {
+        currentProgram.store(program);
+    }
+
+    if (version >= 2 && stream.getNumBytesRemaining() >= static_cast<juce::int64>(sizeof(int))) {
+        setDualCoreProcessing((stream.readInt() & dualCoreFlag) != 0);
+    }
+
+    // Older sessions ran the Normal network
+    const int quality = version >= 3 && stream.getNumBytesRemaining() >= static_cast<juce::int64>(sizeof(int))
+        ? stream.readInt() : static_cast<int>(ReverbNetworkSize::standard);
+    addStateValue("quality", static_cast<float>(juce::jlimit(0, qualityParameter->choices.size() - 1, quality)));
+
+    apvts.replaceState(state);
+
+    DBG("Binary state restored, version " << version);
+    return true;
+}
+
+void DSP256XLReverbProcessor::readXmlState(const void* data, int sizeInBytes) {
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
     if (xmlState.get() != nullptr && xmlState->hasTagName(apvts.state.getType())) {
         apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
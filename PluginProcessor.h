@@ -1,114 +1,333 @@
 #pragma once
 #include <JuceHeader.h>
+#include "ReverbProfiler.h"
+#include "TailAnalyser.h"
+#include "LateNetworkHelper.h"
 
 // One-pole lowpass filter for damping in comb filters
+template <typename SampleType>
 class OnePole {
 public:
     OnePole();
-    float process(float input, float coeff);
+    SampleType process(SampleType input, SampleType coeff);
     void reset();
     void clear();
 
 private:
-    float state;
+    SampleType state;
 };
 
 // Frequency-dependent damping filter for better HF response
+template <typename SampleType>
 class DampingFilter {
 public:
     DampingFilter();
-    void setCoeffs(float lpCoeff, float hpCoeff);
-    float process(float input);
+    void setCoeffs(SampleType lpCoeff, SampleType hpCoeff);
+    SampleType process(SampleType input);
     void clear();
 
 private:
-    float lpCoeff, hpCoeff;
-    float lpState, hpState;
+    SampleType lpCoeff, hpCoeff;
+    SampleType lpState, hpState;
 };
 
 // Enhanced comb filter with frequency-dependent damping
+template <typename SampleType>
 class EnhancedCombFilter {
 public:
     EnhancedCombFilter();
     void setSize(int samples);
-    float process(float input, float stereoSpread = 0.0f);
-    void setDamping(float lpVal, float hpVal);
-    void setFeedback(float val);
+    SampleType process(SampleType input, SampleType stereoSpread = 0);
+    void setDamping(SampleType lpVal, SampleType hpVal);
+    void setFeedback(SampleType val);
     void clear();
 
 private:
-    std::vector<float> buffer;
+    std::vector<SampleType> buffer;
     int writeIndex;
-    DampingFilter damping;
-    float feedback, dampingLP, dampingHP;
+    DampingFilter<SampleType> damping;
+    SampleType feedback, dampingLP, dampingHP;
 };
 
 // Lowpass Feedback Comb Filter (LFCF)
+template <typename SampleType>
 class CombFilter {
 public:
     CombFilter();
     void setSize(int samples);
-    float process(float input);
-    void setDamp(float val);
-    void setFeedback(float val);
+    void reserve(int samples);
+    SampleType process(SampleType input);
+    void setDamp(SampleType val);
+    void setFeedback(SampleType val);
     void clear();
 
+    // First-order low and high shelves in the feedback path, for separate
+    // low/high decay times. Coefficients are one-pole crossover coefficients;
+    // gains are relative to the broadband feedback, and gains of 1 bypass them.
+    void setShelves(SampleType lowCoeff, SampleType highCoeff, SampleType lowGain, SampleType highGain);
+
+    // Blends the loop toward lossless: at 1 the contents circulate unchanged
+    // (unity feedback, damping and shelves bypassed). The blend is folded into
+    // the loop coefficients, so the per-sample cost is the same at any amount.
+    void setFreeze(SampleType amount);
+
     // Make buffer accessible for size checking
-    std::vector<float> buffer;
-    float feedback;  // Made public for fade-out reset
+    std::vector<SampleType> buffer;
+    SampleType feedback;  // Made public for fade-out reset
 
 private:
     int writeIndex;
-    OnePole lowpass;
-    float damp;
+    OnePole<SampleType> lowpass;
+    SampleType damp;
+
+    OnePole<SampleType> lowShelf, highShelf;
+    SampleType lowShelfCoeff = 0, highShelfCoeff = 0;
+    SampleType lowShelfGain = 1, highShelfGain = 1;
+    bool shelving = false;
+
+    // Coefficients the loop runs with: the ones above blended by freeze
+    SampleType freeze = 0;
+    SampleType loopFeedback, loopDamp;
+    SampleType loopLowGain = 1, loopHighGain = 1;
+    void updateLoop();
 };
 
 // Allpass filter for diffusion
+template <typename SampleType>
 class AllpassFilter {
 public:
     AllpassFilter();
     void setSize(int samples);
-    float process(float input);
-    void setCoeff(float val);
+    void reserve(int samples);
+    SampleType process(SampleType input);
+    void setCoeff(SampleType val);
     void clear();
 
     // Make buffer accessible for size checking
-    std::vector<float> buffer;
+    std::vector<SampleType> buffer;
 
 private:
     int writeIndex;
-    float coeff;
+    SampleType coeff;
+};
+
+// Series chain of allpass stages run as one fused per-sample loop, with
+// coefficients clamped when they are set rather than per sample. Each stage
+// can nest a second allpass inside its delay (a lattice section) for more
+// echo density per stage; without nesting the output matches a chain of
+// AllpassFilters exactly.
+template <typename SampleType>
+class AllpassCascade {
+public:
+    static constexpr int maxStages = 8;
+
+    void setNumStages(int num);
+    int getNumStages() const { return numStages; }
+
+    void setSize(int stage, int samples);
+    int getSize(int stage) const { return static_cast<int>(stages[static_cast<size_t>(stage)].outer.buffer.size()); }
+    void reserve(int stage, int samples);
+    void setCoeff(int stage, SampleType val);
+
+    // Nests an allpass of this many samples inside the stage's delay; 0 removes it
+    void setNestedSize(int stage, int samples);
+
+    void clear();
+    void process(SampleType* buffer, int numSamples);
+
+    // Bytes allocated for the stages' delay lines
+    size_t getMemoryBytes() const;
+
+    // Runs two cascades with the same number of stages side by side (L and R
+    // lanes), interleaving their independent recursions in one loop
+    static void processPair(AllpassCascade& a, AllpassCascade& b, SampleType* left, SampleType* right, int numSamples);
+
+private:
+    struct Line {
+        std::vector<SampleType> buffer;
+        int index = 0;
+    };
+
+    struct Stage {
+        Line outer, inner;
+        SampleType coeff = SampleType(0.5f);
+        bool nested = false;
+    };
+
+    std::array<Stage, maxStages> stages;
+    int numStages = 0;
+
+    static void resize(Line& line, int samples);
+    static SampleType tick(Stage& stage, SampleType input);
 };
 
 // Simple delay line
+template <typename SampleType>
 class DelayLine {
 public:
     DelayLine();
     void setSize(int samples);
+    void reserve(int samples);
     void setDelay(int samples);
-    float process(float input);
+    SampleType process(SampleType input);
+
+    // Zeroes the buffer but keeps the delay set by setDelay(), so a line
+    // cleared mid-stream still delays by the same amount afterwards
     void clear();
 
+    // Sample written this many writes before the most recent one
+    SampleType tap(int samplesAgo) const;
+
     // Make buffer accessible for size checking
-    std::vector<float> buffer;
+    std::vector<SampleType> buffer;
 
 private:
     int writeIndex, readIndex, delaySamples;
 };
 
+// Flat snapshot of every automatable parameter, in APVTS layout order
+struct ReverbParameters {
+    enum Index {
+        decay = 0, preDelay, damping, diffusion, reverbDiffusion,
+        size, volume, early, reflectionDelay, subsequentDelay,
+        subsequentLevel, envelopment, position, reflectivity, tieLevel,
+        mix, lowDecay, highDecay, inputDiffusion, duck,
+        duckAttack, duckRelease, mode, gateLength, freeze,
+        numParameters
+    };
+
+    // APVTS parameter ID for each index
+    static const char* getID(int index);
+
+    float operator[](int index) const { return values[static_cast<size_t>(index)]; }
+    float& operator[](int index) { return values[static_cast<size_t>(index)]; }
+
+    // Defaults match createParameterLayout()
+    std::array<float, numParameters> values = {
+        2.0f, 20.0f, 0.5f, 0.7f, 0.7f,
+        0.75f, 1.0f, 0.3f, 1.0f, 1.0f,
+        0.8f, 0.8f, 0.5f, 0.8f, 0.5f,
+        0.5f, 1.0f, 1.0f, 0.0f, 0.0f,
+        5.0f, 200.0f, 0.0f, 300.0f, 0.0f
+    };
+};
+
+// Late-output modes: the plain tail, a gated tail that closes once the input
+// has been quiet for the gate length, or the tail played back in reversed
+// segments of the gate length
+enum class ReverbMode { normal = 0, gated, reverse };
+
+// Network sizes a voice can be built with; the quality parameter's Eco,
+// Normal and High tiers in that order
+enum class ReverbNetworkSize { lite = 0, standard, dense };
+
+// Delay tables for one network size. The line counts are template arguments,
+// so every per-line loop in ReverbProcessor has a compile-time trip count.
+template <int NumCombs, int NumAllpasses, int NumTaps>
+struct ReverbTopology {
+    static constexpr int numCombs = NumCombs;
+    static constexpr int numAllpasses = NumAllpasses;
+    static constexpr int numTaps = NumTaps;
+
+    // Combs and allpasses run at the sample rate divided by this
+    static constexpr int tailDecimation = 1;
+
+    // Separate left/right early-tap lines, or one set fed the mono sum
+    static constexpr bool stereoEarlyTaps = true;
+};
+
+// Eco: per stereo sample, 4 comb and 2 allpass lines per channel at half
+// rate plus 4 mono taps, a quarter of Normal's line updates and about 0.4x
+// its time in a stubbed build (see ReverbMeasurement::measureQualityTiers).
+// The tail's damping and band-decay shelves act at the half rate, so it is
+// darker and loses the air above a quarter of the sample rate; early
+// reflections are centred rather than spread.
+struct LiteTopology : ReverbTopology<4, 2, 4> {
+    static constexpr int tailDecimation = 2;
+    static constexpr bool stereoEarlyTaps = false;
+
+    static constexpr std::array<float, numCombs> combDelaysMs = { 31.3f, 37.1f, 41.1f, 44.3f };
+    static constexpr std::array<float, numAllpasses> allpassDelaysMs = { 5.0f, 1.7f };
+    static constexpr std::array<float, numTaps> earlyTapDelaysMs = { 8.3f, 15.2f, 19.8f, 28.9f };
+};
+
+// Normal: base delay times in milliseconds (Schroeder algorithm), 8 comb and
+// 4 allpass lines per channel and 6 stereo taps, all at the full rate
+struct StandardTopology : ReverbTopology<8, 4, 6> {
+    static constexpr std::array<float, numCombs> combDelaysMs = { 29.7f, 37.1f, 41.1f, 43.7f, 31.3f, 34.9f, 39.5f, 44.3f };
+    static constexpr std::array<float, numAllpasses> allpassDelaysMs = { 5.0f, 1.7f, 12.7f, 9.3f };
+    static constexpr std::array<float, numTaps> earlyTapDelaysMs = { 8.3f, 11.7f, 15.2f, 19.8f, 24.1f, 28.9f };
+};
+
+// High: 12 comb and 6 allpass lines per channel and 8 stereo taps, about
+// 1.3x Normal's time in a stubbed build, for a denser, smoother tail
+struct DenseTopology : ReverbTopology<12, 6, 8> {
+    static constexpr std::array<float, numCombs> combDelaysMs = { 29.7f, 37.1f, 41.1f, 43.7f, 31.3f, 34.9f,
+                                                                  39.5f, 44.3f, 47.9f, 50.3f, 53.9f, 56.7f };
+    static constexpr std::array<float, numAllpasses> allpassDelaysMs = { 5.0f, 1.7f, 3.1f, 12.7f, 9.3f, 7.3f };
+    static constexpr std::array<float, numTaps> earlyTapDelaysMs = { 8.3f, 11.7f, 15.2f, 19.8f, 24.1f, 28.9f, 33.6f, 38.2f };
+};
+
+// What the voice manager needs from a voice, whatever its network size
+template <typename SampleType>
+class ReverbVoice {
+public:
+    virtual ~ReverbVoice() = default;
+
+    virtual void prepare(double sr) = 0;
+    virtual void clear() = 0;
+
+    // Audio thread: clear without a click, spread over the next few blocks
+    virtual void resetWithFade() = 0;
+
+    virtual void processStereo(SampleType* left, SampleType* right, int numSamples) = 0;
+    virtual void setParameters(const ReverbParameters& params) = 0;
+    virtual float getReverbLevel() const = 0;
+
+    // Decay, damping and mix smoother values, so a new voice can start from
+    // another one's (for crossfades)
+    virtual std::array<float, 3> getSmootherState() const = 0;
+    virtual void inheritSmootherState(const ReverbVoice& other) = 0;
+
+    virtual void reserveParallelRendering(int maxBlockSize) = 0;
+    virtual void setRenderPool(juce::ThreadPool* pool) = 0;
+    virtual void setLateNetworkHelper(LateNetworkHelper* h) = 0;
+    virtual void setTailAnalyser(TailAnalyser* a) = 0;
+#if DRMK_ENABLE_PROFILING
+    virtual void setProfiler(ReverbProfiler* p) = 0;
+#endif
+
+    // Bytes held by the voice, its delay lines included
+    virtual size_t getMemoryBytes() const = 0;
+
+    virtual void setSidechain(const SampleType* left, const SampleType* right) = 0;
+};
+
+// Builds a voice with the given network size
+template <typename SampleType>
+std::unique_ptr<ReverbVoice<SampleType>> createReverbVoice(ReverbNetworkSize size);
+
 // Main Reverb Processor
-class ReverbProcessor {
+// Instantiated for float and double and for each topology; parameters stay
+// float either way, the recursive filter state and signal path use SampleType.
+// There are no separate double kernels: the comb, allpass and delay
+// recursions are scalar per-sample loops at either precision, and only the
+// element-wise passes (FloatVectorOperations) use JUCE's SIMD paths.
+template <typename SampleType, typename Topology = StandardTopology>
+class ReverbProcessor : public ReverbVoice<SampleType> {
 public:
     ReverbProcessor();
-    void prepare(double sr);
-    void clear();
-    void processStereo(float* left, float* right, int numSamples);
+    void prepare(double sr) override;
+    void clear() override;
+    void processStereo(SampleType* left, SampleType* right, int numSamples) override;
 
     // Get current reverb tail level (for visualization)
-    float getReverbLevel() const { return reverbLevel; }
+    float getReverbLevel() const override { return reverbLevel; }
 
-    // Reset with fade to avoid clicks
-    void resetWithFade();
+    // Audio thread: fades the wet signal out over the next few milliseconds of
+    // processStereo, clears the network a piece per block, then fades back in
+    void resetWithFade() override;
+    bool isResetting() const { return resetState != ResetState::idle; }
 
     // Parameter setters
     void setDecayTime(float seconds);
@@ -127,19 +346,123 @@ public:
     void setTieLevel(float val);
     void setPosition(float val);
     void setDryWet(float val);
+    void setLowDecay(float multiplier);
+    void setHighDecay(float multiplier);
+    void setInputDiffusion(float amount);
+    void setDucking(float amount, float attackMs, float releaseMs);
+    void setMode(ReverbMode newMode, float lengthMs);
+    void setFreeze(bool shouldFreeze);
+    void setParameters(const ReverbParameters& params) override;
 
-private:
-    float sampleRate = 44100.0f;
+    // Audio thread: key for the ducker, read along with the next processStereo
+    // calls (which advance it); nullptr ducks under the dry input
+    void setSidechain(const SampleType* left, const SampleType* right) override { sidechainL = left; sidechainR = right; }
+
+    // Largest values the delay-length setters accept; these match the APVTS
+    // ranges, so each line can be sized once for its longest reachable delay
+    static constexpr float maxPreDelayMs = 200.0f;
+    static constexpr float maxRoomSize = 2.0f;
+    static constexpr float maxReflectionDelay = 2.0f;
+    static constexpr float maxSubsequentDelay = 2.0f;
+
+    // Allocates every delay buffer for its longest reachable delay, once, so
+    // later size changes never allocate
+    void reserveMaxSizes();
+
+    size_t getMemoryBytes() const override;
+
+    // Start the smoothers from another voice's current values (for crossfades)
+    std::array<float, 3> getSmootherState() const override;
+    void inheritSmootherState(const ReverbVoice<SampleType>& other) override;
+
+#if DRMK_ENABLE_PROFILING
+    void setProfiler(ReverbProfiler* p) override { profiler = p; }
+#endif
+
+    // Receives this voice's wet output for the tail spectrogram (nullptr for none)
+    void setTailAnalyser(TailAnalyser* a) override { tailAnalyser = a; }
+
+    // Block-sized buffers that let the two channels' late networks run on
+    // separate threads; called off the audio thread
+    void reserveParallelRendering(int maxBlockSize) override;
 
-    // Base delay times in milliseconds (Schroeder algorithm)
-    std::vector<float> baseCombDelaysMs = { 29.7f, 37.1f, 41.1f, 43.7f, 31.3f, 34.9f, 39.5f, 44.3f };
-    std::vector<float> baseAllpassDelaysMs = { 5.0f, 1.7f, 12.7f, 9.3f };
-    std::vector<float> earlyTapDelaysMs = { 8.3f, 11.7f, 15.2f, 19.8f, 24.1f, 28.9f };
+    // Audio thread: pool to share the late networks with, nullptr to run serially
+    void setRenderPool(juce::ThreadPool* pool) override { renderPool = pool; }
 
-    std::vector<CombFilter> combsL, combsR;
-    std::vector<AllpassFilter> allpassesL, allpassesR;
-    DelayLine preDelayL, preDelayR;
-    std::vector<std::pair<DelayLine, DelayLine>> earlyTaps;
+    // Audio thread: real-time helper for the right late network, nullptr for none
+    void setLateNetworkHelper(LateNetworkHelper* h) override { lateNetworkHelper = h; }
+
+private:
+    float sampleRate = 44100.0f;
+    float tailSampleRate = 44100.0f;
+    bool prepared = false;
+
+    static constexpr const auto& baseCombDelaysMs = Topology::combDelaysMs;
+    static constexpr const auto& baseAllpassDelaysMs = Topology::allpassDelaysMs;
+    static constexpr const auto& earlyTapDelaysMs = Topology::earlyTapDelaysMs;
+
+    // Input diffuser between the pre-delay and the comb bank (Dattorro's
+    // lengths and coefficients), blended in by inputDiffusion
+    static constexpr int numInputDiffuserStages = 4;
+    static constexpr float inputDiffuserDelaysMs[numInputDiffuserStages] = { 4.77f, 3.6f, 12.73f, 9.31f };
+    static constexpr float inputDiffuserCoeffs[numInputDiffuserStages] = { 0.75f, 0.75f, 0.625f, 0.625f };
+    AllpassCascade<SampleType> inputDiffuserL, inputDiffuserR;
+    float inputDiffusion = 0.0f, lastInputDiffusion = 0.0f;
+
+    // Ducker: a peak follower on the sidechain (or dry input) turns the wet
+    // signal down by up to duckAmount, fully once the key reaches -12 dBFS
+    static constexpr float duckFullScale = 4.0f;
+    float duckAmount = 0.0f, duckAttackMs = 5.0f, duckReleaseMs = 200.0f;
+    SampleType duckAttackCoeff = 0, duckReleaseCoeff = 0, duckEnvelope = 0;
+    const SampleType* sidechainL = nullptr;
+    const SampleType* sidechainR = nullptr;
+    void updateDuckingCoeffs();
+    void processDucking(int numSamples, int blockOffset);
+
+    // Freeze: the comb loops go lossless and their input is muted, ramped
+    // over freezeRampSeconds in both directions
+    static constexpr float freezeRampSeconds = 0.25f;
+    juce::LinearSmoothedValue<float> freezeSmoother;
+    float freezeAmount = 0.0f;
+    void updateFreeze(int numSamples);
+
+    // resetWithFade() state machine. The wet gain ramps over resetFadeSeconds;
+    // while it is muted, one clear step runs per block, upstream stages first,
+    // so no single block pays for zeroing every buffer at once
+    enum class ResetState { idle, fadingOut, clearing, fadingIn };
+    static constexpr float resetFadeSeconds = 0.01f;
+    ResetState resetState = ResetState::idle;
+    float resetGain = 1.0f, resetFadeStep = 1.0f;
+    int resetClearStep = 0;
+    void processResetFade(int numSamples);
+    void advanceReset();
+    bool clearStep(int step);
+
+    // Gated and reverse modes act on the late output before the mix; both use
+    // buffers sized in prepare(), so switching modes never allocates
+    static constexpr float maxGateLengthMs = 1000.0f;
+    static constexpr float gateThreshold = 0.01f;  // -40 dBFS on the dry input
+    static constexpr float gateReleaseMs = 20.0f;
+    ReverbMode mode = ReverbMode::normal;
+    float gateLengthMs = 300.0f;
+    int gateHoldRemaining = 0;
+    SampleType gateGain = 0;
+    DelayLine<SampleType> reverseL, reverseR;
+    int reversePhase = 0;
+    void processMode(int numSamples);
+    void processGate(int numSamples);
+    void processReverse(int numSamples);
+
+    void advanceSidechain(int numSamples) {
+        if (sidechainL == nullptr) return;
+        sidechainL += numSamples;
+        sidechainR += numSamples;
+    }
+
+    std::array<CombFilter<SampleType>, Topology::numCombs> combsL, combsR;
+    AllpassCascade<SampleType> allpassesL, allpassesR;
+    DelayLine<SampleType> preDelayL, preDelayR;
+    std::array<std::pair<DelayLine<SampleType>, DelayLine<SampleType>>, Topology::numTaps> earlyTaps;
 
     // Reverb parameters
     float decayTime = 2.0f, preDelayMs = 20.0f, damping = 0.5f, diffusion = 0.7f, reverbDiffusion = 0.7f;
@@ -147,8 +470,67 @@ private:
     float subsequentReverbDelay = 1.0f, subsequentLevel = 0.8f, envelopment = 0.8f;
     float normalizedReflectivity = 0.8f, tieLevel = 0.5f, tieLevelGain = 1.0f, position = 0.5f, dryWet = 0.5f;
 
+    // Low/high band decay times as multiples of decayTime, split at these crossovers
+    float lowDecayMultiplier = 1.0f, highDecayMultiplier = 1.0f;
+    static constexpr float lowCrossoverHz = 250.0f, highCrossoverHz = 4000.0f;
+
+    // Inputs the comb feedback and shelves were last computed from
+    std::array<float, 5> lastFeedbackInputs{};
+
+    // Last sizes the delay lines were built for
+    float lastRoomSize = 0.75f, lastRefDelay = 1.0f, lastSubDelay = 1.0f;
+
     // For visualization and debugging
     float reverbLevel = 0.0f;
+    TailAnalyser* tailAnalyser = nullptr;
+
+#if DRMK_ENABLE_PROFILING
+    ReverbProfiler* profiler = nullptr;
+#endif
+
+    // Scratch buffers so each stage runs as its own pass over a sub-block
+    static constexpr int maxSubBlockSize = 256;
+    std::array<SampleType, maxSubBlockSize> dryBufL{}, dryBufR{}, preBufL{}, preBufR{};
+    std::array<SampleType, maxSubBlockSize> earlyBufL{}, earlyBufR{}, lateBufL{}, lateBufR{};
+    std::array<float, maxSubBlockSize> wetMonoBuf{};
+    std::array<SampleType, maxSubBlockSize> duckGainBuf{};
+
+    // Offline renders: whole chunks of the input stages are kept here while
+    // the left and right late networks run in parallel. Decimated tails also
+    // keep their shared tail-rate input and each channel's tail-rate output.
+    enum ParallelChannel { dryL = 0, dryR, preL, preR, earlyL, earlyR, lateL, lateR,
+        tailInL, tailInR, tailOutL, tailOutR, numParallelChannels };
+    juce::AudioBuffer<SampleType> parallelBuffer;
+    juce::ThreadPool* renderPool = nullptr;
+    LateNetworkHelper* lateNetworkHelper = nullptr;
+    static void runRightLateNetwork(void* context, int numSamples);
+
+    // Runs the right channel's late network on the render pool
+    class LateNetworkJob : public juce::ThreadPoolJob {
+    public:
+        explicit LateNetworkJob(ReverbProcessor& p) : juce::ThreadPoolJob("DRMKII late network"), owner(p) {}
+        JobStatus runJob() override;
+
+        int numSamples = 0;
+        std::atomic<bool> finished{ false };
+
+    private:
+        ReverbProcessor& owner;
+    };
+    LateNetworkJob lateNetworkJob{ *this };
+
+    // Decimated tails: both channels' combs read the same averaged input, so
+    // it is decimated once per sub-block (or chunk); only the interpolation
+    // back to the full rate is per channel
+    struct TailDecimator {
+        SampleType sumL = 0, sumR = 0;
+        int phase = 0, startPhase = 0, numLow = 0;
+    };
+    struct TailInterpolator {
+        SampleType previous = 0, next = 0;
+    };
+    TailDecimator tailDecimator;
+    std::array<TailInterpolator, 2> tailInterpolators{};
 
     // Smoothing filters for parameter changes
     juce::LinearSmoothedValue<float> decaySmoother, dampingSmoother, mixSmoother;
@@ -156,9 +538,26 @@ private:
     // Initialize smoothers
     void initSmoothers(double sampleRate);
 
+    // Processing stages, each over one sub-block
+    void processPreDelay(const SampleType* left, const SampleType* right, int numSamples);
+    void processEarlyTaps(int numSamples);
+    void processInputDiffuser(int numSamples);
+    void processCombs(int channel, const SampleType* inL, const SampleType* inR, SampleType* out, int numSamples);
+    void processAllpasses(int channel, SampleType* buffer, int numSamples);
+    void processLateNetwork(int channel, int numSamples);
+    void decimateTailInput(const SampleType* inL, const SampleType* inR, SampleType* lowL, SampleType* lowR, int numSamples);
+    void processLateDecimated(int channel, const SampleType* lowL, const SampleType* lowR, SampleType* lowOut,
+        SampleType* out, int numSamples);
+    void processStereoParallel(SampleType* left, SampleType* right, int numSamples,
+        float& currentDecay, float& currentDamping, float& currentMix);
+    void processOutput(SampleType* left, SampleType* right, int numSamples, int blockOffset,
+        float& currentDecay, float& currentDamping, float& currentMix);
+
     int msToSamples(float ms);
+    int msToTailSamples(float ms) { return msToSamples(ms / Topology::tailDecimation); }
     void updateAllParameters();
     void updateFeedback();
+    void updateDecayShelves();
     void updateDamping();
     void updateDiffusion();
     void updatePreDelay();
@@ -167,15 +566,237 @@ private:
     void updateSubsequentDelays();
 };
 
+// Runs the active reverb voice and keeps a pre-allocated standby voice, so a
+// program change can switch to a fresh voice without allocating while the old
+// voice's tail rings out underneath it
+template <typename SampleType>
+class ReverbVoiceManager {
+public:
+    explicit ReverbVoiceManager(ReverbNetworkSize size = ReverbNetworkSize::standard);
+
+    void prepare(double sampleRate, int maxBlockSize);
+    void clear();
+    void process(SampleType* left, SampleType* right, int numSamples);
+
+    // Audio thread: fade out and clear the active voice, and any tail still
+    // fading out under it
+    void resetWithFade();
+
+    // Parameters from the host go to the active voice only
+    ReverbVoice<SampleType>& getActive() { return *active; }
+
+    // Audio thread: switch to a new parameter set; false while a previous
+    // switch is still fading out
+    bool switchTo(const ReverbParameters& params);
+    bool isSwitching() const { return fadeRemaining > 0; }
+
+    // Engines built for a quality change fade in over the engine they replace,
+    // which keeps running on the same input until the crossfade ends. With no
+    // engine to replace (waking from hibernation) they fade in from the dry signal.
+    void setFadesIn(bool shouldFadeIn) { fadesIn = shouldFadeIn; }
+    bool isFadingIn() const { return fadesIn; }
+    void startCrossfade() { crossfadeRemaining = crossfadeLength; }
+    bool isCrossfading() const { return crossfadeRemaining > 0; }
+
+    // Prepare request this engine was built for, set by ReverbEngineHolder,
+    // which drops engines from requests that have since been superseded
+    void setGeneration(int newGeneration) { generation = newGeneration; }
+    int getGeneration() const { return generation; }
+
+    // Audio thread: process with the previous engine, or the unprocessed input
+    // if there is none, faded out underneath; true once the crossfade has finished
+    bool processCrossfade(ReverbVoiceManager* outgoing, SampleType* left, SampleType* right, int numSamples);
+
+#if DRMK_ENABLE_PROFILING
+    void setProfiler(ReverbProfiler* p);
+#endif
+
+    // Only the active voice feeds the analyser
+    void setTailAnalyser(TailAnalyser* a);
+
+    // Audio thread: share each voice's late networks with this pool (offline only)
+    // or with a real-time helper thread
+    void setRenderPool(juce::ThreadPool* pool);
+    void setLateNetworkHelper(LateNetworkHelper* helper);
+
+    // Audio thread: ducker key for the next process() call, nullptr for the dry input
+    void setSidechain(const SampleType* left, const SampleType* right);
+
+    // Bytes held by both voices and the fade buffers
+    size_t getMemoryBytes() const;
+
+private:
+    std::unique_ptr<ReverbVoice<SampleType>> active, standby;
+    TailAnalyser* tailAnalyser = nullptr;
+
+    // The outgoing voice is fed silence and faded over this long
+    static constexpr float tailFadeSeconds = 0.75f;
+
+    juce::AudioBuffer<SampleType> tailBuffer;
+    int fadeLength = 0, fadeRemaining = 0;
+
+    // Engine crossfade: short enough to follow a quality switch promptly,
+    // long enough not to click
+    static constexpr float crossfadeSeconds = 0.1f;
+
+    juce::AudioBuffer<SampleType> crossfadeBuffer;
+    int crossfadeLength = 0, crossfadeRemaining = 0;
+    bool fadesIn = false;
+    int generation = 0;
+};
+
+// Worker threads shared by every plugin instance, preparing engines off the
+// audio and message threads: after prepareToPlay, so a sample-rate change
+// prepares every instance in parallel, and for quality changes and waking
+// from hibernation
+struct EnginePreparationPool {
+    juce::ThreadPool pool{ juce::jmax(1, juce::SystemStats::getNumCpus() - 1) };
+};
+
+// Workers shared by every instance for offline bounces; the audio thread
+// itself runs the left channel, so one fewer than the number of cores
+struct ParallelRenderPool {
+    juce::ThreadPool pool{ juce::jmax(1, juce::SystemStats::getNumCpus() - 1) };
+};
+
+// Running engine for one sample type. Engines are prepared on the shared
+// pool (or in place, offline) and swapped in by the audio thread; engines
+// replacing a running one crossfade from it. Replaced engines are freed on the
+// message thread.
+template <typename SampleType>
+class ReverbEngineHolder {
+public:
+    using Engine = ReverbVoiceManager<SampleType>;
+
+    // Hand-off point for engines prepared on other threads. The audio thread
+    // only ever takes the engine out with an exchange; every other thread
+    // publishes under the lock, so an engine prepared for a superseded request
+    // never replaces a newer one.
+    struct PreparedSlot {
+        std::atomic<Engine*> engine{ nullptr };
+        std::atomic<int> generation{ 0 };
+        juce::CriticalSection lock;
+
+        ~PreparedSlot() { delete engine.exchange(nullptr); }
+
+        // Supersede every request made so far; returns the new request's generation
+        int nextGeneration() {
+            const juce::ScopedLock sl(lock);
+            return ++generation;
+        }
+
+        // Hand over an engine prepared for request newGeneration. Left with
+        // the caller if a newer request has been made since.
+        void publish(std::unique_ptr<Engine>& newEngine, int newGeneration) {
+            std::unique_ptr<Engine> unclaimed;  // Never taken by the audio thread; freed after unlocking
+            const juce::ScopedLock sl(lock);
+            if (generation.load() != newGeneration) return;
+            unclaimed.reset(engine.exchange(newEngine.release(), std::memory_order_acq_rel));
+        }
+    };
+
+    class PrepareJob;
+
+    ReverbEngineHolder();
+    ~ReverbEngineHolder();
+
+    // Null until the first engine has been taken, and while hibernating
+    Engine* get() const { return engine.get(); }
+
+    // Message thread, while the audio thread is stopped (prepareToPlay):
+    // drop everything and have newEngine prepared on the pool. If the first
+    // block arrives before the pool has started on it, finishStartup() builds
+    // it on the audio thread instead.
+    void startPrepare(juce::ThreadPool& pool, std::unique_ptr<Engine> newEngine, double sampleRate, int maxBlockSize);
+
+    // Audio thread, with no engine running: prepare the startup engine here if
+    // the pool has not started on it yet, or wait for the pool to finish it,
+    // then take it; true if one was retired
+    bool finishStartup();
+
+    // Message thread: queue a new engine to be prepared on the pool. With
+    // crossfade, the running engine fades out underneath the new one instead
+    // of being cut off.
+    void requestPrepare(juce::ThreadPool& pool, std::unique_ptr<Engine> newEngine,
+        double sampleRate, int maxBlockSize, bool crossfade = false);
+
+    // As requestPrepare(), but prepared on the calling thread, so the next
+    // takePrepared() picks it up. For offline renders.
+    void prepareNow(std::unique_ptr<Engine> newEngine, double sampleRate, int maxBlockSize, bool crossfade = false);
+
+    // Audio thread: swap in a prepared engine; true if one was retired
+    bool takePrepared();
+
+    // Audio thread: run the engine, crossfading from the one it replaced if
+    // that is still fading; true if the outgoing engine was retired
+    bool process(SampleType* left, SampleType* right, int numSamples);
+
+    // Audio thread: retire every running engine so its delay memory is freed
+    // on the message thread; true if one was retired
+    bool hibernate();
+
+    // Message thread: free retired engines, or drop everything (once the
+    // audio thread has stopped)
+    void freeRetired();
+    void release();
+
+    // Audio thread: ducker key for the next process() call, for every running engine
+    void setSidechain(const SampleType* left, const SampleType* right);
+
+    // Audio thread: reset every running engine without a click
+    void resetWithFade();
+
+    // Bytes held by the running engines, published by the audio thread
+    // whenever they change
+    size_t getMemoryBytes() const { return memoryBytes.load(std::memory_order_relaxed); }
+
+private:
+    void updateMemoryBytes();
+    std::atomic<size_t> memoryBytes{ 0 };
+
+    // Audio thread: hand an engine to the message thread for freeing; false
+    // (and the engine kept) while every retire slot is taken
+    bool retire(std::unique_ptr<Engine>& oldEngine);
+
+    // pending: taken from the slot, waiting for a crossfade to end or for a
+    // free retire slot. Only the audio thread touches it while running.
+    std::unique_ptr<Engine> engine, outgoing, pending;
+    std::shared_ptr<PreparedSlot> prepared = std::make_shared<PreparedSlot>();
+    std::array<std::atomic<Engine*>, 4> retired{};
+
+    // prepareToPlay's job, owned here so the audio thread can take it over;
+    // kept until release()
+    std::unique_ptr<PrepareJob> startupJob;
+    juce::ThreadPool* startupPool = nullptr;
+};
+
+// Factory program: a name plus a full parameter set
+struct ReverbProgram {
+    const char* name;
+    ReverbParameters params;
+};
+
 // Audio Processor
-class DSP256XLReverbProcessor : public juce::AudioProcessor {
+class DSP256XLReverbProcessor : public juce::AudioProcessor,
+    private juce::AsyncUpdater {
 public:
     DSP256XLReverbProcessor();
+    ~DSP256XLReverbProcessor() override;
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&) override;
+    void processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override;
+    void processBlockBypassed(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&) override;
+
+    // Stereo in and out, plus an optional mono or stereo sidechain that keys the ducker
+    bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
     void releaseResources() override;
 
+    // Host transport reset: the next block fades the tail out and clears it
+    void reset() override;
+
     const juce::String getName() const override;
     bool acceptsMidi() const override;
     bool producesMidi() const override;
@@ -195,8 +816,126 @@ public:
     // Access to parameter tree
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
+#if DRMK_ENABLE_PROFILING
+    // CPU instrumentation (debug builds only)
+    const ReverbProfiler& getProfiler() const { return profiler; }
+#endif
+
+    // Bytes this instance holds, its engines and delay memory included, for
+    // planning large sessions. Zero engine memory while suspended or hibernating.
+    size_t getMemoryBytes() const;
+
+    // Wet-signal spectrogram for the editor's tail view
+    TailAnalyser& getTailAnalyser() { return tailAnalyser; }
+
+    // Opt-in: runs the right channel's late network on a helper thread in real
+    // time, for configurations that exceed one core. Switched from the editor's
+    // 2 CPU button rather than a parameter. Message thread; saved with the state.
+    void setDualCoreProcessing(bool shouldUseTwoCores);
+    bool isDualCoreProcessing() const { return dualCore.load(std::memory_order_relaxed); }
+    const LateNetworkHelper& getLateNetworkHelper() const { return lateNetworkHelper; }
+
+    // Network the engine is built with, following the "quality" parameter
+    ReverbNetworkSize getNetworkSize() const { return networkSize; }
+
+    // Built-in program bank
+    static int getNumFactoryPrograms();
+    static const ReverbProgram& getFactoryProgram(int index);
+
 private:
-    ReverbProcessor reverb;
+    // One engine per precision; only the one the host uses is prepared
+    ReverbEngineHolder<float> floatEngine;
+    ReverbEngineHolder<double> doubleEngine;
+    double requestedSampleRate = 0.0;
+    int requestedBlockSize = 0;
+    bool requestedDoublePrecision = false;
+    ReverbNetworkSize networkSize = ReverbNetworkSize::standard;
+    ReverbNetworkSize requestedNetworkSize = ReverbNetworkSize::standard;
+    juce::SharedResourcePointer<EnginePreparationPool> preparationPool;
+    juce::SharedResourcePointer<ParallelRenderPool> renderPool;
+
+    template <typename SampleType>
+    ReverbEngineHolder<SampleType>& getEngine();
+
+    // Engine for the current network size and parameters, not yet prepared
+    template <typename SampleType>
+    std::unique_ptr<ReverbVoiceManager<SampleType>> createEngine();
+
+    // prepareToPlay: has the engine prepared on the shared pool
+    template <typename SampleType>
+    void prepareEngine(double sampleRate, int samplesPerBlock);
+
+    // Changes while running (quality, waking from hibernation) crossfade to
+    // a rebuilt engine. The message thread has it prepared on the pool;
+    // offline renders build it on the audio thread so a bounce never depends
+    // on thread timing.
+    template <typename SampleType>
+    void rebuildEngine(bool buildNow);
+    void updateEngine(bool buildNow);
+
+    // Guards the requested configuration between prepareToPlay, the message
+    // thread and offline renders; never taken by a real-time audio thread
+    juce::CriticalSection engineLock;
+
+    // Quality tier (Eco, Normal, High) as a ReverbNetworkSize index. The audio
+    // thread compares it with the tier last requested and asks the message
+    // thread to rebuild when they differ.
+    juce::AudioParameterChoice* qualityParameter = nullptr;
+    std::atomic<int> requestedQuality{ static_cast<int>(ReverbNetworkSize::standard) };
+
+    template <typename SampleType>
+    void processBlockInternal(juce::AudioBuffer<SampleType>& buffer);
+
+    template <typename SampleType>
+    void processBlockBypassedInternal(juce::AudioBuffer<SampleType>& buffer);
+
+    // Hibernation: an instance that is suspended (releaseResources) or has
+    // been bypassed for longer than its tail gives up its engine and delay
+    // memory. A suspended instance is rebuilt by the next prepareToPlay; a
+    // bypassed one is rebuilt through updateEngine() when processing resumes,
+    // passing the dry signal through until the engine is ready.
+    static constexpr double minHibernateSeconds = 1.0;
+    int bypassedSamples = 0;
+    std::atomic<bool> hibernating{ false }, wakeRequested{ false };
+
+    // Set by reset(), which hosts may call from any thread
+    std::atomic<bool> resetRequested{ false };
+
+    void handleAsyncUpdate() override;
+
+    // Raw parameter values in ReverbParameters order, looked up once
+    std::array<std::atomic<float>*, ReverbParameters::numParameters> rawParameters{};
+    ReverbParameters readParameters() const;
+
+    // Audio thread: the host's values, or false while setCurrentProgram() is
+    // still writing a program into the APVTS
+    bool readHostParameters(ReverbParameters& params) const;
+
+    // Program requested by the host, picked up on the audio thread
+    std::atomic<int> currentProgram{ 0 }, pendingProgram{ -1 };
+
+    // Each setCurrentProgram() bumps programRequests before it writes the
+    // program's values and publishes the same count in programsWritten after
+    std::atomic<int> programRequests{ 0 }, programsWritten{ 0 };
+
+    // Binary state: magic, version, current program, parameter count, the
+    // parameter values in ReverbParameters order, then (version 2) option flags
+    // and (version 3) the quality tier
+    static constexpr int stateMagic = 0x4b4d5244;  // "DRMK"
+    static constexpr int stateVersion = 3;
+    static constexpr int dualCoreFlag = 1;
+    static constexpr int maxStoredParameters = 1024;  // anything larger is a corrupt blob
+    bool readBinaryState(const void* data, int sizeInBytes);
+    void readXmlState(const void* data, int sizeInBytes);
+
+#if DRMK_ENABLE_PROFILING
+    ReverbProfiler profiler;
+#endif
+
+    TailAnalyser tailAnalyser;
+
+    LateNetworkHelper lateNetworkHelper;
+    std::atomic<bool> dualCore{ false };
 
     // Parameter state management (JUCE 8 style)
     juce::AudioProcessorValueTreeState apvts;
@@ -0,0 +1,399 @@
+// ReverbMeasurement.h
+#pragma once
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+//==============================================================================
+// Offline impulse-response measurement for regression checks
+// Renders ReverbProcessor impulse responses over a parameter grid (in parallel
+// on a thread pool), measures T60, EDT, echo density and spectral centroid,
+// and compares the results against a stored golden baseline.
+// Not used by the plugin itself; drive it from a command-line host or debugger.
+//==============================================================================
+class ReverbMeasurement
+{
+public:
+    struct Metrics
+    {
+        float t60 = 0.0f;              // seconds, Schroeder integration (T30, or T20 if the floor is too high)
+        float edt = 0.0f;              // early decay time, seconds
+        float mixingTimeMs = 0.0f;     // first time the normalised echo density reaches 1
+        float centroidEarlyHz = 0.0f;  // mean spectral centroid over the first 200ms
+        float centroidLateHz = 0.0f;   // mean spectral centroid from 200ms to T60 / 2
+
+        std::vector<float> echoDensity;  // normalised echo density, one value per hop
+        std::vector<float> centroidHz;   // spectral centroid, one value per hop
+        float hopSeconds = 0.0f;
+    };
+
+    struct GridPoint
+    {
+        juce::String name;
+        ReverbParameters params;
+    };
+
+    struct Result
+    {
+        GridPoint point;
+        Metrics metrics;
+    };
+
+    // Cost and sound of one quality tier
+    struct TierResult
+    {
+        ReverbNetworkSize size = ReverbNetworkSize::standard;
+        juce::String name;
+        double nanosPerSample = 0.0;  // per stereo sample, best of several runs
+        Metrics metrics;
+    };
+
+    // Relative tolerances, e.g. 0.05 = 5%
+    struct Tolerance
+    {
+        float t60 = 0.05f, edt = 0.10f, mixingTime = 0.15f, centroid = 0.10f;
+    };
+
+    static constexpr double preRollSeconds = 0.1;  // lets the parameter smoothers settle
+    static constexpr float impulseLevel = 0.5f;    // keeps the output limiter out of the way
+
+    //==============================================================================
+    // Wet-only stereo impulse response, starting at the impulse
+    static juce::AudioBuffer<float> renderImpulseResponse(ReverbParameters params, double sampleRate, double seconds)
+    {
+        return renderImpulseResponse(params, sampleRate, seconds, ReverbNetworkSize::standard);
+    }
+
+    static juce::AudioBuffer<float> renderImpulseResponse(ReverbParameters params, double sampleRate, double seconds,
+        ReverbNetworkSize size)
+    {
+        params[ReverbParameters::mix] = 1.0f;
+
+        auto voice = createReverbVoice<float>(size);
+        auto& reverb = *voice;
+        reverb.setParameters(params);
+        reverb.prepare(sampleRate);
+
+        const int preRoll = static_cast<int>(sampleRate * preRollSeconds);
+        const int length = juce::jmax(1, static_cast<int>(sampleRate * seconds));
+
+        juce::AudioBuffer<float> buffer(2, preRoll + length);
+        buffer.clear();
+        buffer.setSample(0, preRoll, impulseLevel);
+        buffer.setSample(1, preRoll, impulseLevel);
+
+        constexpr int blockSize = 512;
+        for (int offset = 0; offset < buffer.getNumSamples(); offset += blockSize) {
+            const int n = juce::jmin(blockSize, buffer.getNumSamples() - offset);
+            reverb.processStereo(buffer.getWritePointer(0) + offset, buffer.getWritePointer(1) + offset, n);
+        }
+
+        juce::AudioBuffer<float> ir(2, length);
+        ir.copyFrom(0, 0, buffer, 0, preRoll, length);
+        ir.copyFrom(1, 0, buffer, 1, preRoll, length);
+        return ir;
+    }
+
+    //==============================================================================
+    static Metrics analyse(const juce::AudioBuffer<float>& ir, double sampleRate)
+    {
+        Metrics m;
+        const int length = ir.getNumSamples();
+        if (length < 2 || ir.getNumChannels() == 0)
+            return m;
+
+        // Mono sum of the channels
+        std::vector<float> h(static_cast<size_t>(length));
+        for (int ch = 0; ch < ir.getNumChannels(); ++ch) {
+            const float* data = ir.getReadPointer(ch);
+            for (int i = 0; i < length; ++i)
+                h[static_cast<size_t>(i)] += data[i] / ir.getNumChannels();
+        }
+
+        // Schroeder backward integration, in dB relative to the total energy
+        std::vector<double> edc(static_cast<size_t>(length));
+        double energy = 0.0;
+        for (int i = length - 1; i >= 0; --i) {
+            energy += static_cast<double>(h[static_cast<size_t>(i)]) * h[static_cast<size_t>(i)];
+            edc[static_cast<size_t>(i)] = energy;
+        }
+        if (energy <= 0.0)
+            return m;
+
+        for (auto& e : edc)
+            e = 10.0 * std::log10(juce::jmax(e / energy, 1.0e-12));
+
+        // T30 when the decay reaches -35dB before the end, otherwise T20
+        const double lowest = edc.back();
+        const double endDb = lowest < -35.0 ? -35.0 : -25.0;
+        m.t60 = decayTimeFromSlope(edc, sampleRate, -5.0, endDb);
+        m.edt = decayTimeFromSlope(edc, sampleRate, 0.0, -10.0);
+
+        analyseEchoDensity(h, sampleRate, m);
+        analyseCentroid(h, sampleRate, m);
+        return m;
+    }
+
+    //==============================================================================
+    // decay x size x damping around the default parameters
+    static std::vector<GridPoint> makeDefaultGrid()
+    {
+        std::vector<GridPoint> grid;
+        for (float decay : { 0.5f, 2.0f, 6.0f })
+            for (float size : { 0.3f, 0.75f, 1.5f })
+                for (float damping : { 0.1f, 0.5f, 0.9f }) {
+                    GridPoint p;
+                    p.name = "decay " + juce::String(decay, 1) + " size " + juce::String(size, 2)
+                        + " damp " + juce::String(damping, 1);
+                    p.params[ReverbParameters::decay] = decay;
+                    p.params[ReverbParameters::size] = size;
+                    p.params[ReverbParameters::damping] = damping;
+                    grid.push_back(p);
+                }
+        return grid;
+    }
+
+    // Renders and analyses every point on the pool's threads, blocking until all are
+    // done (so never call it from one of those threads)
+    static std::vector<Result> measureGrid(const std::vector<GridPoint>& grid, double sampleRate, double seconds,
+        juce::ThreadPool& pool)
+    {
+        std::vector<Result> results(grid.size());
+        std::atomic<int> remaining{ static_cast<int>(grid.size()) };
+        juce::WaitableEvent finished;
+
+        for (size_t i = 0; i < grid.size(); ++i) {
+            pool.addJob([&, i] {
+                results[i].point = grid[i];
+                results[i].metrics = analyse(renderImpulseResponse(grid[i].params, sampleRate, seconds), sampleRate);
+
+                if (--remaining == 0)
+                    finished.signal();
+            });
+        }
+
+        if (!grid.empty())
+            finished.wait();
+        return results;
+    }
+
+    //==============================================================================
+    // Quality tiers at one parameter set. Cost is the time to process stereo
+    // noise in 512-sample blocks on the calling thread; the metrics show what
+    // each tier does to the sound. ReverbHarness tiers at the default
+    // parameters, 48kHz, 8s, best of 5 runs (numRuns), x86-64 Xeon, GCC 12
+    // -O2. The figures come from a stubbed build, not a JUCE one:
+    // FloatVectorOperations were plain loops, so the vectorised stages cost
+    // more than in a shipping build.
+    //
+    //   tier    ns/sample  T60     EDT     mixing  centroid early/late
+    //   Eco     63.7       1.72s   1.01s   300ms   5242 / 921Hz
+    //   Normal  168.0      1.70s   0.94s   180ms   8279 / 1647Hz
+    //   High    219.2      1.67s   0.97s   130ms   8846 / 1897Hz
+    //
+    //   Eco    - 4 combs + 2 allpasses per channel at half rate, 4 mono taps.
+    //            A quarter of Normal's line updates but about 0.4x its time,
+    //            since the taps, diffuser and output stages still run at
+    //            full rate.
+    //            Darker tail and slower echo build-up.
+    //   Normal - 8 combs + 4 allpasses per channel, 6 stereo taps.
+    //   High   - 12 combs + 6 allpasses per channel, 8 stereo taps. About
+    //            1.3x Normal's time; denser tail, earlier mixing time.
+    // Timings vary with the machine and JUCE build; rerun on the target for
+    // its numbers.
+    static std::vector<TierResult> measureQualityTiers(const ReverbParameters& params, double sampleRate,
+        double seconds)
+    {
+        constexpr int blockSize = 512;
+        constexpr int numRuns = 5;
+        const int length = juce::jmax(blockSize, static_cast<int>(sampleRate * seconds));
+
+        juce::AudioBuffer<float> noise(2, length), work(2, length);
+        juce::Random random(0x5eed);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < length; ++i)
+                noise.setSample(ch, i, random.nextFloat() * 0.5f - 0.25f);
+
+        std::vector<TierResult> results;
+        const char* names[] = { "Eco", "Normal", "High" };
+
+        for (auto size : { ReverbNetworkSize::lite, ReverbNetworkSize::standard, ReverbNetworkSize::dense }) {
+            TierResult r;
+            r.size = size;
+            r.name = names[static_cast<int>(size)];
+
+            auto voice = createReverbVoice<float>(size);
+            voice->setParameters(params);
+            voice->prepare(sampleRate);
+
+            double bestSeconds = 0.0;
+            for (int run = 0; run < numRuns; ++run) {
+                work.makeCopyOf(noise, true);
+                voice->clear();
+
+                const auto start = juce::Time::getHighResolutionTicks();
+                for (int offset = 0; offset < length; offset += blockSize) {
+                    const int n = juce::jmin(blockSize, length - offset);
+                    voice->processStereo(work.getWritePointer(0) + offset, work.getWritePointer(1) + offset, n);
+                }
+                const double elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+                bestSeconds = run == 0 ? elapsed : juce::jmin(bestSeconds, elapsed);
+            }
+
+            r.nanosPerSample = bestSeconds * 1.0e9 / length;
+            r.metrics = analyse(renderImpulseResponse(params, sampleRate, seconds, size), sampleRate);
+            results.push_back(r);
+        }
+        return results;
+    }
+
+    //==============================================================================
+    // Golden baseline: one <Point> per grid point holding its summary metrics
+    static std::unique_ptr<juce::XmlElement> createBaseline(const std::vector<Result>& results)
+    {
+        auto xml = std::make_unique<juce::XmlElement>("ReverbBaseline");
+        for (const auto& r : results) {
+            auto* point = xml->createNewChildElement("Point");
+            point->setAttribute("name", r.point.name);
+            point->setAttribute("t60", r.metrics.t60);
+            point->setAttribute("edt", r.metrics.edt);
+            point->setAttribute("mixingTimeMs", r.metrics.mixingTimeMs);
+            point->setAttribute("centroidEarlyHz", r.metrics.centroidEarlyHz);
+            point->setAttribute("centroidLateHz", r.metrics.centroidLateHz);
+        }
+        return xml;
+    }
+
+    // One line per metric that moved outside its tolerance; empty if everything matches
+    static juce::StringArray compareWithBaseline(const std::vector<Result>& results, const juce::XmlElement& baseline)
+    {
+        return compareWithBaseline(results, baseline, Tolerance());
+    }
+
+    static juce::StringArray compareWithBaseline(const std::vector<Result>& results, const juce::XmlElement& baseline,
+        const Tolerance& tolerance)
+    {
+        juce::StringArray deviations;
+
+        for (const auto& r : results) {
+            const auto* golden = baseline.getChildByAttribute("name", r.point.name);
+            if (golden == nullptr) {
+                deviations.add(r.point.name + ": missing from baseline");
+                continue;
+            }
+
+            auto check = [&](const char* metric, float measured, float limit) {
+                const auto expected = static_cast<float>(golden->getDoubleAttribute(metric));
+                const float deviation = std::abs(measured - expected) / juce::jmax(std::abs(expected), 1.0e-6f);
+                if (deviation > limit)
+                    deviations.add(r.point.name + ": " + metric + " " + juce::String(measured, 3)
+                        + " vs " + juce::String(expected, 3) + " (" + juce::String(deviation * 100.0f, 1) + "%)");
+            };
+
+            check("t60", r.metrics.t60, tolerance.t60);
+            check("edt", r.metrics.edt, tolerance.edt);
+            check("mixingTimeMs", r.metrics.mixingTimeMs, tolerance.mixingTime);
+            check("centroidEarlyHz", r.metrics.centroidEarlyHz, tolerance.centroid);
+            check("centroidLateHz", r.metrics.centroidLateHz, tolerance.centroid);
+        }
+        return deviations;
+    }
+
+private:
+    static constexpr int fftOrder = 10;
+    static constexpr int fftSize = 1 << fftOrder;
+
+    // Least-squares slope of the decay curve between two levels, extrapolated to -60dB
+    static float decayTimeFromSlope(const std::vector<double>& edc, double sampleRate, double startDb, double endDb)
+    {
+        double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+        int count = 0;
+
+        for (size_t i = 0; i < edc.size(); ++i) {
+            if (edc[i] > startDb) continue;
+            if (edc[i] < endDb) break;
+
+            const double x = static_cast<double>(i) / sampleRate;
+            sumX += x; sumY += edc[i]; sumXX += x * x; sumXY += x * edc[i];
+            ++count;
+        }
+
+        const double denominator = count * sumXX - sumX * sumX;
+        if (count < 2 || denominator <= 0.0)
+            return 0.0f;
+
+        const double slope = (count * sumXY - sumX * sumY) / denominator;  // dB per second
+        return slope < 0.0 ? static_cast<float>(-60.0 / slope) : 0.0f;
+    }
+
+    // Abel & Huang normalised echo density over 20ms windows, 10ms apart:
+    // the fraction of samples outside one standard deviation, divided by the
+    // Gaussian expectation erfc(1/sqrt(2))
+    static void analyseEchoDensity(const std::vector<float>& h, double sampleRate, Metrics& m)
+    {
+        const int window = juce::jmax(1, static_cast<int>(sampleRate * 0.02));
+        const int hop = juce::jmax(1, window / 2);
+        const double gaussianFraction = std::erfc(1.0 / std::sqrt(2.0));
+        const int length = static_cast<int>(h.size());
+
+        m.mixingTimeMs = 0.0f;
+        for (int start = 0; start + window <= length; start += hop) {
+            double power = 0.0;
+            for (int i = start; i < start + window; ++i)
+                power += static_cast<double>(h[static_cast<size_t>(i)]) * h[static_cast<size_t>(i)];
+            const double sigma = std::sqrt(power / window);
+
+            int outside = 0;
+            for (int i = start; i < start + window; ++i)
+                if (std::abs(h[static_cast<size_t>(i)]) > sigma)
+                    ++outside;
+
+            const auto density = static_cast<float>((static_cast<double>(outside) / window) / gaussianFraction);
+            m.echoDensity.push_back(density);
+
+            if (m.mixingTimeMs == 0.0f && density >= 1.0f)
+                m.mixingTimeMs = static_cast<float>((start + window / 2) * 1000.0 / sampleRate);
+        }
+    }
+
+    static void analyseCentroid(const std::vector<float>& h, double sampleRate, Metrics& m)
+    {
+        juce::dsp::FFT fft(fftOrder);
+        juce::dsp::WindowingFunction<float> window(static_cast<size_t>(fftSize), juce::dsp::WindowingFunction<float>::hann, false);
+        std::vector<float> frame(static_cast<size_t>(fftSize) * 2);
+
+        const int hop = fftSize / 2;
+        const int length = static_cast<int>(h.size());
+        const float binHz = static_cast<float>(sampleRate) / fftSize;
+        m.hopSeconds = static_cast<float>(hop / sampleRate);
+
+        double earlySum = 0.0, lateSum = 0.0;
+        int earlyCount = 0, lateCount = 0;
+        const double lateEnd = juce::jmax(0.4, m.t60 * 0.5);
+
+        for (int start = 0; start + fftSize <= length; start += hop) {
+            std::fill(frame.begin(), frame.end(), 0.0f);
+            std::copy(h.begin() + start, h.begin() + start + fftSize, frame.begin());
+            window.multiplyWithWindowingTable(frame.data(), static_cast<size_t>(fftSize));
+            fft.performFrequencyOnlyForwardTransform(frame.data());
+
+            double weighted = 0.0, total = 0.0;
+            for (int bin = 1; bin < fftSize / 2; ++bin) {
+                weighted += static_cast<double>(bin) * binHz * frame[static_cast<size_t>(bin)];
+                total += frame[static_cast<size_t>(bin)];
+            }
+
+            const auto centroid = total > 0.0 ? static_cast<float>(weighted / total) : 0.0f;
+            m.centroidHz.push_back(centroid);
+
+            const double t = (start + fftSize / 2) / sampleRate;
+            if (t < 0.2) { earlySum += centroid; ++earlyCount; }
+            else if (t < lateEnd) { lateSum += centroid; ++lateCount; }
+        }
+
+        m.centroidEarlyHz = earlyCount > 0 ? static_cast<float>(earlySum / earlyCount) : 0.0f;
+        m.centroidLateHz = lateCount > 0 ? static_cast<float>(lateSum / lateCount) : 0.0f;
+    }
+};
@@ -0,0 +1,240 @@
+// ReverbProfiler.h
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <chrono>
+
+// Profiling is compiled in for debug builds only. Define DRMK_ENABLE_PROFILING=1
+// in the project settings to keep it in a release build.
+#ifndef DRMK_ENABLE_PROFILING
+ #if JUCE_DEBUG
+  #define DRMK_ENABLE_PROFILING 1
+ #else
+  #define DRMK_ENABLE_PROFILING 0
+ #endif
+#endif
+
+#if DRMK_ENABLE_PROFILING
+
+//==============================================================================
+// Per-block CPU instrumentation
+// Written lock-free from the audio thread, read from any thread.
+//==============================================================================
+class ReverbProfiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum Stage { preDelayStage = 0, earlyTapStage, diffuserStage, combStage, allpassStage, outputStage, numStages };
+
+    // Histogram buckets are powers of two in ns/sample: [0,1), [1,2), [2,4) ...
+    static constexpr int numHistogramBins = 16;
+
+    // Histogram and worst-case values are aged out every this many blocks
+    static constexpr uint32_t windowBlocks = 2048;
+
+    struct Snapshot
+    {
+        float nsPerSample = 0.0f;                 // smoothed, whole processBlock
+        float stageNsPerSample[numStages] = {};   // smoothed, per ReverbProcessor stage
+        float worstBlockMicros = 0.0f;            // worst block over the last two windows
+        float cpuLoad = 0.0f;                     // smoothed block time / block duration
+        float worstCpuLoad = 0.0f;
+        uint32_t histogram[numHistogramBins] = {};
+        uint64_t numBlocks = 0;
+    };
+
+    static const char* getStageName(int stage)
+    {
+        static const char* names[] = { "pre-delay", "early taps", "input diffuser", "combs", "allpasses", "output" };
+        return juce::isPositiveAndBelow(stage, static_cast<int>(numStages)) ? names[stage] : "";
+    }
+
+    void setSampleRate(double sr) { sampleRate.store(sr > 0.0 ? sr : 44100.0, std::memory_order_relaxed); }
+
+    // Audio thread: accumulate time spent in one stage of the current block
+    void addStageTime(Stage stage, Clock::duration elapsed) noexcept
+    {
+        pendingStageNs[stage] += static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    // Audio thread: publish one finished block
+    void addBlock(Clock::duration elapsed, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return;
+
+        const auto ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        const auto perSample = static_cast<float>(ns / numSamples);
+        const auto blockMicros = static_cast<float>(ns * 0.001);
+        const auto load = static_cast<float>(ns * 1.0e-9 * sampleRate.load(std::memory_order_relaxed) / numSamples);
+
+        smooth(nsPerSample, perSample);
+        smooth(cpuLoad, load);
+
+        for (int s = 0; s < numStages; ++s) {
+            smooth(stageNsPerSample[s], static_cast<float>(pendingStageNs[s] / numSamples));
+            pendingStageNs[s] = 0.0;
+        }
+
+        int bin = 0;
+        for (auto v = static_cast<uint32_t>(perSample); v > 0 && bin < numHistogramBins - 1; v >>= 1)
+            ++bin;
+        histogram[bin].fetch_add(1, std::memory_order_relaxed);
+
+        if (blockMicros > worstBlockMicros.load(std::memory_order_relaxed))
+            worstBlockMicros.store(blockMicros, std::memory_order_relaxed);
+        if (load > worstCpuLoad.load(std::memory_order_relaxed))
+            worstCpuLoad.store(load, std::memory_order_relaxed);
+
+        // Age the window: halve the histogram and roll the worst case over
+        if (++blocksInWindow >= windowBlocks) {
+            blocksInWindow = 0;
+            for (auto& b : histogram)
+                b.store(b.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+            previousWorstBlockMicros.store(worstBlockMicros.exchange(0.0f, std::memory_order_relaxed), std::memory_order_relaxed);
+            previousWorstCpuLoad.store(worstCpuLoad.exchange(0.0f, std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        numBlocks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Snapshot getSnapshot() const
+    {
+        Snapshot s;
+        s.nsPerSample = nsPerSample.load(std::memory_order_relaxed);
+        for (int i = 0; i < numStages; ++i)
+            s.stageNsPerSample[i] = stageNsPerSample[i].load(std::memory_order_relaxed);
+        s.worstBlockMicros = juce::jmax(worstBlockMicros.load(std::memory_order_relaxed),
+                                        previousWorstBlockMicros.load(std::memory_order_relaxed));
+        s.cpuLoad = cpuLoad.load(std::memory_order_relaxed);
+        s.worstCpuLoad = juce::jmax(worstCpuLoad.load(std::memory_order_relaxed),
+                                    previousWorstCpuLoad.load(std::memory_order_relaxed));
+        for (int i = 0; i < numHistogramBins; ++i)
+            s.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+        s.numBlocks = numBlocks.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // Single LCD line, e.g. "CPU 38ns/smp 1.2% PK 96us"
+    juce::String getSummary() const
+    {
+        const auto s = getSnapshot();
+        return "CPU " + juce::String(s.nsPerSample, 0) + "ns/smp "
+            + juce::String(s.cpuLoad * 100.0f, 1) + "% PK "
+            + juce::String(s.worstBlockMicros, 0) + "us";
+    }
+
+    // Scoped timers used through the DRMK_PROFILE_* macros below
+    struct ScopedBlock
+    {
+        ScopedBlock(ReverbProfiler* p, int n) noexcept : profiler(p), numSamples(n), start(Clock::now()) {}
+        ~ScopedBlock() { if (profiler != nullptr) profiler->addBlock(Clock::now() - start, numSamples); }
+
+        ReverbProfiler* profiler;
+        int numSamples;
+        Clock::time_point start;
+    };
+
+    struct ScopedStage
+    {
+        ScopedStage(ReverbProfiler* p, Stage s) noexcept : profiler(p), stage(s), start(Clock::now()) {}
+        ~ScopedStage() { if (profiler != nullptr) profiler->addStageTime(stage, Clock::now() - start); }
+
+        ReverbProfiler* profiler;
+        Stage stage;
+        Clock::time_point start;
+    };
+
+private:
+    static void smooth(std::atomic<float>& target, float value) noexcept
+    {
+        const float old = target.load(std::memory_order_relaxed);
+        target.store(old + 0.05f * (value - old), std::memory_order_relaxed);
+    }
+
+    std::atomic<double> sampleRate { 44100.0 };
+    std::atomic<float> nsPerSample { 0.0f }, cpuLoad { 0.0f };
+    std::atomic<float> stageNsPerSample[numStages] {};
+    std::atomic<float> worstBlockMicros { 0.0f }, previousWorstBlockMicros { 0.0f };
+    std::atomic<float> worstCpuLoad { 0.0f }, previousWorstCpuLoad { 0.0f };
+    std::atomic<uint32_t> histogram[numHistogramBins] {};
+    std::atomic<uint64_t> numBlocks { 0 };
+
+    // Audio thread only
+    double pendingStageNs[numStages] = {};
+    uint32_t blocksInWindow = 0;
+};
+
+//==============================================================================
+// Message-thread paint cost, summed over every instrumented paint() call
+// Used as the editor's GUI frame-time benchmark; message thread only.
+//==============================================================================
+class GuiPaintProfiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static GuiPaintProfiler& getInstance()
+    {
+        static GuiPaintProfiler instance;
+        return instance;
+    }
+
+    void addPaint(Clock::duration elapsed) noexcept
+    {
+        paintTime += elapsed;
+        ++numPaints;
+        worstPaint = juce::jmax(worstPaint, elapsed);
+    }
+
+    // Paint time per second of wall clock since the previous call, e.g.
+    // "GUI 1.4ms/s 52 paints PK 180us", then starts a new measurement period
+    juce::String takeSummary()
+    {
+        const auto now = Clock::now();
+        const double periodSeconds = std::chrono::duration<double>(now - periodStart).count();
+        const double paintMillis = std::chrono::duration<double, std::milli>(paintTime).count();
+        const double worstMicros = std::chrono::duration<double, std::micro>(worstPaint).count();
+
+        const auto summary = "GUI " + juce::String(periodSeconds > 0.0 ? paintMillis / periodSeconds : 0.0, 1)
+            + "ms/s " + juce::String(numPaints) + " paints PK " + juce::String(worstMicros, 0) + "us";
+
+        periodStart = now;
+        paintTime = Clock::duration::zero();
+        worstPaint = Clock::duration::zero();
+        numPaints = 0;
+        return summary;
+    }
+
+    struct ScopedPaint
+    {
+        ScopedPaint() noexcept : start(Clock::now()) {}
+        ~ScopedPaint() { GuiPaintProfiler::getInstance().addPaint(Clock::now() - start); }
+
+        Clock::time_point start;
+    };
+
+private:
+    Clock::time_point periodStart = Clock::now();
+    Clock::duration paintTime = Clock::duration::zero();
+    Clock::duration worstPaint = Clock::duration::zero();
+    int numPaints = 0;
+};
+
+ #define DRMK_PROFILE_BLOCK(profiler, numSamples) \
+    ReverbProfiler::ScopedBlock drmkBlockTimer_ ((profiler), (numSamples))
+ #define DRMK_PROFILE_STAGE(profiler, stage) \
+    ReverbProfiler::ScopedStage JUCE_JOIN_MACRO (drmkStageTimer_, __LINE__) ((profiler), ReverbProfiler::stage)
+ #define DRMK_PROFILE_PAINT() \
+    GuiPaintProfiler::ScopedPaint JUCE_JOIN_MACRO (drmkPaintTimer_, __LINE__)
+
+#else
+
+ #define DRMK_PROFILE_BLOCK(profiler, numSamples)
+ #define DRMK_PROFILE_STAGE(profiler, stage)
+ #define DRMK_PROFILE_PAINT()
+
+#endif
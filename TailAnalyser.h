@@ -0,0 +1,186 @@
+// TailAnalyser.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+
+//==============================================================================
+// Decay spectrogram of the wet signal
+// The audio thread pushes decimated mono wet samples into a lock-free FIFO;
+// a background thread windows and FFTs them and publishes one column of
+// log-spaced band levels (dB) per hop for the editor to draw. Nothing is
+// pushed or analysed unless an editor has started it.
+//==============================================================================
+class TailAnalyser : private juce::Thread
+{
+public:
+    static constexpr int fftOrder = 10;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 2;
+    static constexpr int decimation = 2;
+    static constexpr int numBands = 32;
+    static constexpr float minDb = -90.0f;
+    static constexpr float lowestBandHz = 40.0f;
+
+    using Column = std::array<float, numBands>;
+
+    TailAnalyser() : juce::Thread("DRMKII tail analyser") {}
+    ~TailAnalyser() override { stop(); }
+
+    void setSampleRate(double sr) { sampleRate.store(sr > 0.0 ? sr : 44100.0, std::memory_order_relaxed); }
+
+    // Message thread: analysis only runs while a view is showing it
+    void start()
+    {
+        if (listening.exchange(true)) return;
+        startThread(juce::Thread::Priority::low);
+    }
+
+    void stop()
+    {
+        if (!listening.exchange(false)) return;
+        stopThread(1000);
+    }
+
+    bool isListening() const noexcept { return listening.load(std::memory_order_relaxed); }
+
+    // Audio thread: wet mono samples, at most one sub-block at a time
+    void push(const float* wet, int numSamples) noexcept
+    {
+        if (!isListening()) return;
+
+        std::array<float, 512> decimated;
+        int numDecimated = 0;
+
+        for (int i = 0; i < numSamples; ++i) {
+            decimationSum += wet[i];
+            if (++decimationCount == decimation) {
+                decimated[static_cast<size_t>(numDecimated++)] = decimationSum / decimation;
+                decimationSum = 0.0f;
+                decimationCount = 0;
+
+                if (numDecimated == static_cast<int>(decimated.size())) {
+                    write(decimated.data(), numDecimated);
+                    numDecimated = 0;
+                }
+            }
+        }
+        write(decimated.data(), numDecimated);
+    }
+
+    // Message thread: pops the oldest finished column, false if there is none
+    bool popColumn(Column& column) noexcept
+    {
+        int start1, size1, start2, size2;
+        columnFifo.prepareToRead(1, start1, size1, start2, size2);
+        if (size1 == 0) return false;
+
+        column = columns[static_cast<size_t>(start1)];
+        columnFifo.finishedRead(1);
+        return true;
+    }
+
+    // Lower edge of a band in Hz
+    float getBandFrequency(int band) const
+    {
+        const float nyquist = static_cast<float>(sampleRate.load(std::memory_order_relaxed)) / decimation * 0.5f;
+        return lowestBandHz * std::pow(nyquist / lowestBandHz, static_cast<float>(band) / numBands);
+    }
+
+private:
+    void write(const float* data, int numSamples) noexcept
+    {
+        int start1, size1, start2, size2;
+        sampleFifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+        // A full FIFO means the analyser fell behind: drop samples rather than block
+        std::copy(data, data + size1, sampleRing.begin() + start1);
+        std::copy(data + size1, data + size1 + size2, sampleRing.begin() + start2);
+        sampleFifo.finishedWrite(size1 + size2);
+    }
+
+    void run() override
+    {
+        // Discard anything left over from the previous session (reader side only)
+        sampleFifo.finishedRead(sampleFifo.getNumReady());
+        history.fill(0.0f);
+
+        while (!threadShouldExit()) {
+            while (sampleFifo.getNumReady() >= hopSize && !threadShouldExit()) {
+                // Slide the analysis window forward by one hop
+                std::copy(history.begin() + hopSize, history.end(), history.begin());
+
+                int start1, size1, start2, size2;
+                sampleFifo.prepareToRead(hopSize, start1, size1, start2, size2);
+                std::copy(sampleRing.begin() + start1, sampleRing.begin() + start1 + size1, history.end() - hopSize);
+                std::copy(sampleRing.begin() + start2, sampleRing.begin() + start2 + size2, history.end() - hopSize + size1);
+                sampleFifo.finishedRead(size1 + size2);
+
+                analyse();
+            }
+
+            wait(10);
+        }
+    }
+
+    void analyse()
+    {
+        std::fill(fftData.begin(), fftData.end(), 0.0f);
+        std::copy(history.begin(), history.end(), fftData.begin());
+        window.multiplyWithWindowingTable(fftData.data(), fftSize);
+        fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+        const float nyquist = static_cast<float>(sampleRate.load(std::memory_order_relaxed)) / decimation * 0.5f;
+        const float binsPerHz = (fftSize * 0.5f) / nyquist;
+
+        // A full-scale sine through a Hann window peaks at fftSize / 4
+        const float normalise = 4.0f / fftSize;
+
+        Column column;
+        for (int band = 0; band < numBands; ++band) {
+            const int firstBin = juce::jlimit(1, fftSize / 2 - 1, static_cast<int>(getBandFrequency(band) * binsPerHz));
+            const int lastBin = juce::jlimit(firstBin, fftSize / 2 - 1, static_cast<int>(getBandFrequency(band + 1) * binsPerHz));
+
+            float peak = 0.0f;
+            for (int bin = firstBin; bin <= lastBin; ++bin)
+                peak = juce::jmax(peak, fftData[static_cast<size_t>(bin)]);
+
+            column[static_cast<size_t>(band)] = juce::jmax(minDb, juce::Decibels::gainToDecibels(peak * normalise, minDb));
+        }
+
+        // Drop the column if the editor isn't keeping up
+        int start1, size1, start2, size2;
+        columnFifo.prepareToWrite(1, start1, size1, start2, size2);
+        if (size1 > 0) {
+            columns[static_cast<size_t>(start1)] = column;
+            columnFifo.finishedWrite(1);
+        }
+    }
+
+    static constexpr int sampleRingSize = fftSize * 8;
+    static constexpr int numColumns = 64;
+
+    std::atomic<bool> listening{ false };
+    std::atomic<double> sampleRate{ 44100.0 };
+
+    // Audio thread only
+    float decimationSum = 0.0f;
+    int decimationCount = 0;
+
+    // Audio thread -> analysis thread
+    juce::AbstractFifo sampleFifo{ sampleRingSize };
+    std::array<float, sampleRingSize> sampleRing{};
+
+    // Analysis thread only
+    juce::dsp::FFT fft{ fftOrder };
+    juce::dsp::WindowingFunction<float> window{ static_cast<size_t>(fftSize), juce::dsp::WindowingFunction<float>::hann, false };
+    std::array<float, fftSize> history{};
+    std::array<float, fftSize * 2> fftData{};
+
+    // Analysis thread -> message thread
+    juce::AbstractFifo columnFifo{ numColumns };
+    std::array<Column, numColumns> columns{};
+
+    JUCE_DECLARE_NON_COPYABLE(TailAnalyser)
+};
@@ -1,6 +1,8 @@
 // ThinBlockLcdDisplay.h
 #pragma once
 #include <JuceHeader.h>
+#include "LcdRenderCache.h"
+#include "ReverbProfiler.h"
 
 //==============================================================================
 // Thin Block LCD Display (For gain visualization)
@@ -8,33 +10,31 @@
 class ThinBlockLcdDisplay final : public juce::Component
 {
 public:
-    ThinBlockLcdDisplay() { setSize(100, 10); }
+    ThinBlockLcdDisplay() : font(juce::Font::getDefaultMonospacedFontName(), 8.0f, juce::Font::plain) { setSize(100, 10); }
 
     void paint(juce::Graphics& g) override {
-        // LCD background
-        g.fillAll(juce::Colour(120, 140, 100));
-        g.setColour(juce::Colour(60, 70, 50));
-        g.drawRect(getLocalBounds(), 1);
-
-        // Draw blocks based on value
-        const int totalBlocks = 10;
-        const float blockWidth = static_cast<float>(getWidth() - 4) / totalBlocks;
-        const float blockHeight = static_cast<float>(getHeight() - 4);
+        DRMK_PROFILE_PAINT();
 
-        // Calculate how many blocks to fill based on normalized value (0-1)
-        const int blocksToFill = juce::jlimit(0, totalBlocks,
-            static_cast<int>(std::round(value * totalBlocks)));
+        // LCD background and border come from the cache
+        background.draw(g, getWidth(), getHeight(), [this](juce::Graphics& bg) {
+            bg.fillAll(LcdColours::backlight);
+            bg.setColour(LcdColours::border);
+            bg.drawRect(getLocalBounds(), 1);
+        });
 
         // Draw filled blocks
-        g.setColour(juce::Colour(20, 25, 15));
-        for (int i = 0; i < blocksToFill; ++i)
+        const float blockWidth = getBlockWidth();
+        const float blockHeight = static_cast<float>(getHeight() - 4);
+
+        g.setColour(LcdColours::ink);
+        for (int i = 0; i < blocksFilled; ++i)
         {
             const float x = 2.0f + i * blockWidth;
             g.fillRect(x, 2.0f, blockWidth - 1.0f, blockHeight);
         }
 
-        // Draw block separators
-        g.setColour(juce::Colour(60, 70, 50));
+        // Draw block separators over the blocks
+        g.setColour(LcdColours::border);
         for (int i = 1; i < totalBlocks; ++i)
         {
             const float x = 2.0f + i * blockWidth;
@@ -42,26 +42,65 @@ public:
         }
 
         // Draw value text at the end
-        g.setColour(juce::Colour(20, 25, 15));
-        g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 8.0f, juce::Font::plain));
-        g.drawText(valueText, getWidth() - 35, 1, 33, getHeight() - 2, juce::Justification::right, false);
+        g.setColour(LcdColours::ink);
+        textGlyphs.draw(g);
+    }
+
+    void resized() override {
+        layoutText();
     }
 
     void setValue(float normalizedValue)
     {
         value = juce::jlimit(0.0f, 1.0f, normalizedValue);
-        repaint();
+
+        // Only the blocks that changed state need repainting
+        const int blocks = juce::jlimit(0, totalBlocks, static_cast<int>(std::round(value * totalBlocks)));
+        if (blocks != blocksFilled)
+        {
+            const float blockWidth = getBlockWidth();
+            const int first = juce::jmin(blocks, blocksFilled);
+            const int last = juce::jmax(blocks, blocksFilled);
+            // One pixel either side for the separators at the edges
+            const int x = static_cast<int>(2.0f + first * blockWidth) - 1;
+            const int right = static_cast<int>(std::ceil(2.0f + last * blockWidth)) + 1;
+
+            blocksFilled = blocks;
+            repaint(x, 2, right - x, getHeight() - 4);
+        }
     }
 
     void setValueText(const juce::String& text)
     {
-        valueText = text;
-        repaint();
+        if (valueText != text)
+        {
+            valueText = text;
+            layoutText();
+            repaint(getTextArea());
+        }
     }
 
 private:
+    static constexpr int totalBlocks = 10;
+
     float value = 0.0f;
+    int blocksFilled = 0;
     juce::String valueText;
 
+    juce::Font font;
+    juce::GlyphArrangement textGlyphs;
+    LcdBackgroundCache background;
+
+    float getBlockWidth() const { return static_cast<float>(getWidth() - 4) / totalBlocks; }
+    juce::Rectangle<int> getTextArea() const { return { getWidth() - 35, 1, 33, getHeight() - 2 }; }
+
+    void layoutText()
+    {
+        const auto area = getTextArea().toFloat();
+        textGlyphs.clear();
+        textGlyphs.addFittedText(font, valueText, area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+            juce::Justification::right, 1, 1.0f);
+    }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ThinBlockLcdDisplay)
 };
\ No newline at end of file